@@ -17,6 +17,8 @@
 #include <math.h>
 #include <mpu6050.h>
 #include <config_manager.h>
+#include <rtc_memory.h>
+#include <plato_table.h>
 #include <log_debug.h>
 
 //--------------------------------------------------------------------------------
@@ -25,6 +27,79 @@
 #define ACCEL_TILT_ERROR        (-127)
 #define ACCEL_TEMPERATURE_ERROR (-127)
 
+//--------------------------------------------------------------------------------
+/* Burst sampling settings. */
+
+/** @brief Number of accelerometer samples collected in the FIFO for a single tilt measurement. */
+#define ACCEL_BURST_SAMPLES             32
+
+/** @brief Number of samples when no motion was detected during the sleep, the hydrometer floats still. */
+#define ACCEL_BURST_SAMPLES_QUIET       16
+
+/** @brief Number of samples when motion was detected during the sleep, the hydrometer may still oscillate. */
+#define ACCEL_BURST_SAMPLES_DISTURBED   64
+
+/**
+ * @brief Sample rate divider, 1 kHz / (1 + divider) gives 25 Hz.
+ *        The FIFO holds 170 samples, 6.8 s at this rate, the burst fills it while wifi connects.
+ */
+#define ACCEL_BURST_SAMPLE_RATE_DIVIDER 39
+
+/** @brief Sampling period for the divider above, in ms. */
+#define ACCEL_BURST_SAMPLE_PERIOD       40
+
+/** @brief Digital low pass filter used during the burst, removes vibrations of the fermenter. */
+#define ACCEL_BURST_DLPF                MPU6050_DLPF_CFG_BW_10
+
+/**
+ * @brief Sample rate divider for the samples still missing when the tilt is read, 1 kHz / (1 + divider) gives 100 Hz.
+ *        Without wifi nothing overlaps the burst and the CPU waits for these samples in delay().
+ */
+#define ACCEL_BURST_SAMPLE_RATE_DIVIDER_FAST 9
+
+/** @brief Sampling period for the divider above, in ms. */
+#define ACCEL_BURST_SAMPLE_PERIOD_FAST  10
+
+/** @brief Digital low pass filter used with the fast sample rate. */
+#define ACCEL_BURST_DLPF_FAST           MPU6050_DLPF_CFG_BW_20
+
+/** @brief Part of the sorted samples rejected on each side before averaging. */
+#define ACCEL_BURST_TRIM_RATIO          0.25
+
+//--------------------------------------------------------------------------------
+/* Wake-on-motion settings. */
+
+/** @brief Motion threshold of the high pass filtered acceleration, in units of 2 mg. */
+#define ACCEL_MOTION_THRESHOLD          10
+
+/** @brief Number of consecutive samples above the threshold signalling motion. */
+#define ACCEL_MOTION_DURATION           1
+
+/** @brief Sampling rate of the accelerometer during the sleep. */
+#define ACCEL_MOTION_WAKE_CTRL          MPU6050_WAKE_CTRL_1_25HZ
+
+/** @brief Tilt dispersion in degrees above which a reading taken after motion is rejected. */
+#define ACCEL_MOTION_DISPERSION_MAX     1.0
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Motion of the hydrometer during the last sleep. */
+enum accel_motion
+{
+    ACCEL_MOTION_UNKNOWN,       /**< Motion detection was not armed before the sleep. */
+    ACCEL_MOTION_QUIET,         /**< No motion was detected. */
+    ACCEL_MOTION_DISTURBED      /**< The hydrometer was moved, e.g. by handling, racking or krausen. */
+};
+
+/** @brief Wake-on-motion state kept in RTC memory across deep sleep. */
+struct accelgyro_rtc
+{
+    uint8_t armed;          /**< 1 if motion detection was armed before the sleep. */
+    uint8_t motion;         /**< @see accel_motion, motion during the last sleep. */
+    uint8_t reserved[2];    /**< Padding. */
+};
+
 //--------------------------------------------------------------------------------
 
 /**
@@ -57,11 +132,45 @@ public:
      */
     void init(uint8_t pin_scl, uint8_t pin_sda);
 
-    /** @brief Puts the sensor into sleep mode to save power. */
+    /**
+     * @brief Puts the sensor into low power mode for the deep sleep of the device.
+     * @note  The accelerometer keeps sampling at ACCEL_MOTION_WAKE_CTRL and latches motion of the hydrometer
+     *        in INT_STATUS, it is read by init() on the next wake-up.
+     */
     void sleep();
 
+    /**
+     * @brief Get the motion of the hydrometer during the last sleep.
+     * @return accel_motion - @see accel_motion
+     */
+    accel_motion get_motion();
+
+    /**
+     * @brief Checks whether the last tilt measurement is contaminated by motion.
+     * @return true if motion was detected during the sleep and the tilt dispersion
+     *         exceeds ACCEL_MOTION_DISPERSION_MAX, otherwise false.
+     */
+    bool is_contaminated();
+
+    /**
+     * @brief Performs the position measurement using the accelerometer
+     *        and calculates the tilt using the given formula.
+     * @note  ACCEL_BURST_SAMPLES are collected in the FIFO from init(), the tilt is the mean of the samples
+     *        left after rejecting ACCEL_BURST_TRIM_RATIO of the lowest and the highest ones.
+     *        The number of samples is lowered or raised when the motion during the sleep is known.
+     */
+    void measure_tilt();
+
+    /**
+     * @brief Get the dispersion of the last tilt measurement.
+     * @return float - interquartile range of the tilt samples in degrees, 0 if a single sample was used
+     */
+    float get_tilt_dispersion();
+
     /**
      * @brief Calculates and returns plato degrees of the concentration of dissolved solids in a brewery wort
+     * @note  The tilt measured by measure_tilt() is used, it is measured here if it was not.
+     *        Each sample left after trimming is converted, the result is their mean.
      * @param [in] temperature - used to calibrate solution density.
      * @return float - Degrees Plato (°P) 
      */
@@ -76,10 +185,32 @@ public:
 private:
 
     /**
-     * @brief Performs the position measurement using the accelerometer
-     *        and calculates the tilt using the given formula.
+     * @brief Starts collecting accelerometer samples in the FIFO at the burst sample rate.
+     *        The sensor samples on its own, the CPU and the radio are free meanwhile.
+     * @return true if successful, otherwise false.
      */
-    void measure_tilt();
+    bool start_burst();
+
+    /**
+     * @brief Reads the samples collected since start_burst(), waits only for the rest of the burst.
+     *        The missing samples are collected at ACCEL_BURST_SAMPLE_RATE_DIVIDER_FAST.
+     * @param [out] samples - buffer for the samples
+     * @param [in] max - size of the buffer
+     * @return size_t - number of read samples
+     */
+    size_t read_burst(vector *samples, size_t max);
+
+    /** @brief Stops the FIFO burst and restores the low power cycle with its filter and sample rate. */
+    void stop_burst();
+
+    /** @brief Reads the motion latched during the sleep and stores it in RTC memory. */
+    void read_motion();
+
+    /**
+     * @brief Arms the motion detection for the sleep.
+     * @return true if successful, otherwise false.
+     */
+    bool arm_motion();
 
     /**
      * @brief Calculates degrees Plato using tilt and correction based on temperature.
@@ -89,15 +220,22 @@ private:
 
     MPU6050 *mpu6050;   /**< Pointer to the MPU6050 class. */
     vector accel;       /**< Buffer for accelerometer data. */
-    double coeff_a;     /**< The coefficient of the function that calculates the density of the solution. */
-    double coeff_b;     /**< The coefficient of the function that calculates the density of the solution. */
-    double coeff_c;     /**< The coefficient of the function that calculates the density of the solution. */
-    double coeff_d;     /**< The coefficient of the function that calculates the density of the solution. */
-    double coeff_e;     /**< The coefficient of the function that calculates the density of the solution. */
+    float gravity_coefficients[5];  /**< Coefficients a to e of the function that calculates the density of the solution. */
     float temperature;  /**< Stores the measured temperature. */
     float tilt;         /**< Stores the calculated tilt. */
+    float tilts[ACCEL_BURST_SAMPLES_DISTURBED];    /**< Sorted tilt samples of the last measurement. */
+    size_t tilts_begin; /**< First tilt sample left after trimming. */
+    size_t tilts_end;   /**< End of the tilt samples left after trimming. */
+    size_t burst_size;  /**< Number of samples of the burst, chosen from the motion during the sleep. */
+    bool burst_started; /**< Flag indicating the FIFO collects the burst. */
+    mpu6050_config_dlpf_cfg low_power_dlpf;    /**< Digital low pass filter replaced by the burst. */
+    uint8_t low_power_divider;  /**< Sample rate divider replaced by the burst. */
+    PlatoTable plato_table; /**< Tilt and temperature to degrees Plato lookup table. */
+    float tilt_dispersion;  /**< Interquartile range of the tilt samples. */
     float plato;        /**< Stores the calculated degrees Plato. */
     bool initialized;   /**< Flag indicating whether the sensor has been initialized and is ready for measurements.*/
+    bool tilt_measured; /**< Flag indicating whether the tilt has been measured since initialization. */
+    accel_motion motion;    /**< Motion of the hydrometer during the last sleep. */
 
 };
 
@@ -16,6 +16,7 @@
 #include <FS.h>
 #include <LittleFS.h>
 #include "log_debug.h"
+#include "rtc_memory.h"
 
 //--------------------------------------------------------------------------------
 
@@ -41,11 +42,26 @@ enum setting
     COEFFICIENT_E
 };
 
+/** @brief Settings kept in RTC memory, so wake-ups from deep sleep do not mount the filesystem. */
+struct config_rtc
+{
+    char ssid[32];          /**< WiFi SSID */
+    char pass[32];          /**< WiFi PASS */
+    uint64_t sleep_time;    /**< Interval between waking up the device. */
+    double coeff_a;         /**< The coefficient of the function that calculates the density of the solution. */
+    double coeff_b;         /**< The coefficient of the function that calculates the density of the solution. */
+    double coeff_c;         /**< The coefficient of the function that calculates the density of the solution. */
+    double coeff_d;         /**< The coefficient of the function that calculates the density of the solution. */
+    double coeff_e;         /**< The coefficient of the function that calculates the density of the solution. */
+};
+
 //--------------------------------------------------------------------------------
 
 /**
  * @brief Singleton class for retrieving settings from a json file stored in flash memory
- *        and for saving new settings in this file. Stores settings in private variables
+ *        and for saving new settings in this file. Stores settings in private variables.
+ *        After deep sleep the settings are restored from RTC memory, the Firebase settings
+ *        are then read from the file only when requested.
  */
 class ConfigManager
 {
@@ -128,6 +144,15 @@ private:
     /** @brief Construct a new Config Manager object. */
     ConfigManager();
 
+    /**
+     * @brief Restore settings from RTC memory, only after wake-up from deep sleep.
+     * @return true if successful, otherwise false.
+     */
+    bool load_rtc();
+
+    /** @brief Save settings needed on every wake-up in RTC memory. */
+    void save_rtc();
+
     static ConfigManager instance;  /**< Static config instance*/
     char *ssid;                     /**< WiFi SSID */
     char *pass;                     /**< WiFi PASS*/
@@ -141,6 +166,8 @@ private:
     double coeff_c;                 /**< The coefficient of the function that calculates the density of the solution. */
     double coeff_d;                 /**< The coefficient of the function that calculates the density of the solution. */
     double coeff_e;                 /**< The coefficient of the function that calculates the density of the solution. */
+    bool loaded;                    /**< Flag indicating whether the settings were read from json file. */
+    bool restored;                  /**< Flag indicating whether the settings were restored from RTC memory. */
 };
 
 //--------------------------------------------------------------------------------
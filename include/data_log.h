@@ -0,0 +1,193 @@
+/**
+ * @file data_log.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef DATA_LOG_H_
+#define DATA_LOG_H_
+
+//--------------------------------------------------------------------------------
+
+#include <FS.h>
+#include <LittleFS.h>
+#include <coredecls.h>
+#include "measurement_codec.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Path of the file with saved measurements. */
+#define DATA_LOG_PATH       "/data.log"
+
+/** @brief Size of a single page of encoded records, in bytes. */
+#define DATA_LOG_PAGE_SIZE  256
+
+/** @brief Number of pages in the log file. */
+#define DATA_LOG_PAGES      64
+
+/** @brief Magic number of a formatted log file, "DLOG". */
+#define DATA_LOG_MAGIC      0x474F4C44
+
+/** @brief Version of the log format, a log of another version is formatted again. */
+#define DATA_LOG_VERSION    3
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Header stored at the beginning of the log file. */
+struct data_log_header
+{
+    uint32_t magic;         /**< DATA_LOG_MAGIC, marks a formatted log. */
+    uint16_t version;       /**< Log format version. */
+    uint16_t codec_version; /**< Version of the records encoding, @see MEASUREMENT_CODEC_VERSION. */
+    uint16_t page_size;     /**< Size of a single page. */
+    uint16_t pages;         /**< Number of pages in the file. */
+    uint32_t head;          /**< Sequence number of the page being filled. */
+    uint32_t tail;          /**< Sequence number of the oldest page. */
+    uint32_t tail_index;    /**< Number of already removed records in the oldest page. */
+    uint32_t count;         /**< Number of records waiting in the log. */
+    uint32_t crc;           /**< CRC32 of the fields above. */
+};
+
+/** @brief Header of a single page, followed by the encoded records. */
+struct data_log_page_header
+{
+    uint32_t sequence;      /**< Sequence number of the page, used to detect stale pages. */
+    uint16_t count;         /**< Number of records in the page. */
+    uint16_t size;          /**< Number of used bytes after the header. */
+    uint32_t crc;           /**< CRC32 of the fields above and the used bytes. */
+};
+
+/** @brief Page of encoded records. */
+struct data_log_page
+{
+    data_log_page_header header;                                        /**< Page header. */
+    uint8_t records[DATA_LOG_PAGE_SIZE - sizeof(data_log_page_header)]; /**< Records encoded with MeasurementCodec. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Fixed-size circular log of measurements in a single preallocated file.
+ *        Records are delta encoded and packed into pages, every page starts a new stream,
+ *        so it can be decoded on its own. Records are appended to the head page and drained
+ *        from the tail page, both in O(1). When the log is full, the oldest page is overwritten.
+ */
+class DataLog
+{
+public:
+
+    /**
+     * @brief Construct a new Data Log object.
+     * @param [in] path - path of the log file
+     * @param [in] pages - number of pages in the log file
+     */
+    DataLog(const char *path = DATA_LOG_PATH, uint16_t pages = DATA_LOG_PAGES);
+
+    /**
+     * @brief Opens the log file, creates and preallocates it if it does not exist or is not valid.
+     * @return true if successful, otherwise false.
+     */
+    bool begin();
+
+    /**
+     * @brief Appends the measurement at the head of the log.
+     * @param [in] measurement - Reference to the structure with measurement data
+     * @return true if successful, otherwise false.
+     */
+    bool append(const data &measurement);
+
+    /**
+     * @brief Appends the measurements at the head of the log, the file is written once.
+     * @param [in] records - Measurements to append, the oldest first
+     * @param [in] count - Number of measurements
+     * @return true if successful, otherwise false.
+     */
+    bool append(const data *records, size_t count);
+
+    /**
+     * @brief Reads the oldest records without removing them.
+     * @note  A corrupted page found at the tail is removed.
+     * @param [out] records - Buffer for the read measurements
+     * @param [in] max - Size of the buffer
+     * @return size_t - number of measurements written to the buffer
+     */
+    size_t read(data *records, size_t max);
+
+    /**
+     * @brief Removes the oldest records from the log.
+     * @param [in] count - Number of records to remove
+     */
+    void drop(uint32_t count);
+
+    /**
+     * @brief Get the number of records waiting in the log.
+     * @return uint32_t - number of records
+     */
+    uint32_t count();
+
+private:
+
+    /**
+     * @brief Creates a new, empty log file with all pages preallocated.
+     * @return true if successful, otherwise false.
+     */
+    bool format();
+
+    /**
+     * @brief Saves the header at the beginning of the log file.
+     * @param [in] file - Opened log file
+     * @return true if successful, otherwise false.
+     */
+    bool write_header(File &file);
+
+    /**
+     * @brief Reads and verifies the page.
+     * @param [in] file - Opened log file
+     * @param [in] sequence - Sequence number of the page
+     * @param [out] page - Buffer for the page
+     * @return true if the page is valid, otherwise false.
+     */
+    bool read_page(File &file, uint32_t sequence, data_log_page *page);
+
+    /**
+     * @brief Saves the page with its CRC.
+     * @param [in] file - Opened log file
+     * @param [in] page - Page to save, the sequence number must be set
+     * @return true if successful, otherwise false.
+     */
+    bool write_page(File &file, data_log_page *page);
+
+    /**
+     * @brief Removes the oldest page from the log.
+     * @param [in] file - Opened log file
+     */
+    void drop_tail_page(File &file);
+
+    /**
+     * @brief Counts records in all valid pages, used after a corrupted page was found.
+     * @param [in] file - Opened log file
+     */
+    void recount(File &file);
+
+    /**
+     * @brief Calculates the position of the page in the log file.
+     * @param [in] sequence - Sequence number of the page
+     * @return uint32_t - offset from the beginning of the file
+     */
+    uint32_t page_offset(uint32_t sequence);
+
+    const char *path;           /**< Path of the log file. */
+    uint16_t pages;             /**< Number of pages in the log file. */
+    data_log_header header;     /**< Copy of the header stored in the file. */
+    data_log_page page;         /**< Buffer for the currently processed page. */
+    MeasurementCodec codec;     /**< Records encoder and decoder. */
+    bool initialized;           /**< Flag indicating whether the log file is opened and valid. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* DATA_LOG_H_ */
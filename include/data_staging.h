@@ -0,0 +1,89 @@
+/**
+ * @file data_staging.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef DATA_STAGING_H_
+#define DATA_STAGING_H_
+
+//--------------------------------------------------------------------------------
+
+#include "rtc_memory.h"
+#include "measurement_codec.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Size of the encoded records kept in the RTC user memory, in bytes. */
+#define DATA_STAGING_SIZE           124
+
+/** @brief Maximum number of staged records, every encoded record takes at least 5 bytes. */
+#define DATA_STAGING_RECORDS_MAX    (DATA_STAGING_SIZE / 5)
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Staged records as stored in the RTC user memory. */
+struct data_staging_buffer
+{
+    uint8_t count;                      /**< Number of staged records. */
+    uint8_t codec_version;              /**< Version of the records encoding, @see MEASUREMENT_CODEC_VERSION. */
+    uint16_t size;                      /**< Number of used bytes. */
+    uint8_t records[DATA_STAGING_SIZE]; /**< Records encoded with MeasurementCodec. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Buffer of measurements in the RTC user memory, kept across deep sleep.
+ *        Offline wake-ups append here without touching the flash, the buffer is moved
+ *        to the DataLog only when it is full or before an upload.
+ * @note  Staged measurements are lost on power loss or a reset other than deep sleep wake-up.
+ */
+class DataStaging
+{
+public:
+
+    /** @brief Construct a new Data Staging object. */
+    DataStaging();
+
+    /**
+     * @brief Appends the measurement to the buffer.
+     * @param [in] measurement - Reference to the structure with measurement data
+     * @return true if successful, false if the buffer is full or could not be written.
+     */
+    bool append(const data &measurement);
+
+    /**
+     * @brief Reads all staged records without removing them.
+     * @param [out] records - Buffer for the read measurements
+     * @param [in] max - Size of the buffer
+     * @return size_t - number of measurements written to the buffer
+     */
+    size_t read(data *records, size_t max);
+
+    /** @brief Removes all staged records. */
+    void clear();
+
+    /**
+     * @brief Get the number of staged records.
+     * @return uint32_t - number of records
+     */
+    uint32_t count();
+
+private:
+
+    /** @brief Reads the buffer from the RTC user memory and restores the encoder state, once per wake-up. */
+    void load();
+
+    data_staging_buffer buffer; /**< Copy of the buffer stored in the RTC user memory. */
+    MeasurementCodec codec;     /**< Encoder positioned after the last staged record. */
+    bool loaded;                /**< Flag indicating whether the buffer was read from the RTC user memory. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* DATA_STAGING_H_ */
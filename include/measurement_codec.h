@@ -0,0 +1,112 @@
+/**
+ * @file measurement_codec.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef MEASUREMENT_CODEC_H_
+#define MEASUREMENT_CODEC_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief Version of the encoded record format. */
+#define MEASUREMENT_CODEC_VERSION   2
+
+/** @brief Maximum size of a single encoded record, five 32-bit varints. */
+#define MEASUREMENT_CODEC_MAX_SIZE  25
+
+#define MEASUREMENT_CODEC_TEMPERATURE_SCALE 16      /**< 1/16 °C, DS18B20 12-bit resolution. */
+#define MEASUREMENT_CODEC_PLATO_SCALE       100     /**< 0.01 °P. */
+#define MEASUREMENT_CODEC_VOLTAGE_SCALE     1000    /**< 1 mV. */
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Measurement data structure. */
+struct data
+{
+    float temperature;      /**< Value of the measured temperature. */
+    float plato;            /**< Value of the measured degrees plato.*/
+    float battery_voltage;  /**< Value of the measured battery voltage. */
+    uint32_t time;          /**< Time of the measurement since epoch, TIME_ERROR if unknown. */
+    uint32_t sequence;      /**< Sequence number of the measurement on the device, identifies it when the time is unknown. */
+};
+
+/** @brief Measurement in fixed-point representation. */
+struct measurement_fixed
+{
+    uint32_t time;          /**< Time since epoch in seconds. */
+    int32_t temperature;    /**< Temperature in 1/16 °C. */
+    int32_t plato;          /**< Degrees plato in 0.01 °P. */
+    int32_t voltage;        /**< Battery voltage in mV. */
+    uint32_t sequence;      /**< Sequence number of the measurement. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Encoder and decoder of a stream of measurements.
+ *        Every record is stored as zigzag varints of the differences to the previous record,
+ *        the time as the difference to the previous time interval and the sequence number
+ *        as the difference to the previous one plus one. After reset() the first
+ *        record is encoded against zero. Encoder and decoder must be reset at the same point of the stream.
+ */
+class MeasurementCodec
+{
+public:
+
+    /** @brief Construct a new Measurement Codec object. */
+    MeasurementCodec();
+
+    /** @brief Starts a new stream, the next record does not depend on the previous ones. */
+    void reset();
+
+    /**
+     * @brief Encodes the measurement and appends it to the stream.
+     * @param [in] measurement - measurement to encode
+     * @param [out] buf - buffer for the encoded record
+     * @param [in] size - size of the buffer
+     * @return size_t - number of bytes written, 0 if the record does not fit, the stream is then unchanged
+     */
+    size_t encode(const data &measurement, uint8_t *buf, size_t size);
+
+    /**
+     * @brief Decodes the next record of the stream.
+     * @param [in] buf - encoded record
+     * @param [in] size - number of bytes available in the buffer
+     * @param [out] measurement - decoded measurement
+     * @return size_t - number of bytes read, 0 if the record is truncated or invalid
+     */
+    size_t decode(const uint8_t *buf, size_t size, data *measurement);
+
+    /**
+     * @brief Converts the measurement to the fixed-point representation, values out of range are saturated.
+     * @param [in] measurement - measurement to convert
+     * @return measurement_fixed - converted measurement
+     */
+    static measurement_fixed to_fixed(const data &measurement);
+
+    /**
+     * @brief Converts the measurement from the fixed-point representation.
+     * @param [in] fixed - measurement to convert
+     * @return data - converted measurement
+     */
+    static data from_fixed(const measurement_fixed &fixed);
+
+private:
+
+    measurement_fixed previous; /**< The last record of the stream. */
+    uint32_t time_interval;     /**< Time between the last two records of the stream. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* MEASUREMENT_CODEC_H_ */
@@ -0,0 +1,124 @@
+/**
+ * @file plato_table.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef PLATO_TABLE_H_
+#define PLATO_TABLE_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <polynomial.h>
+
+//--------------------------------------------------------------------------------
+
+/* Tilt axis of the table, in degrees. */
+#define PLATO_TABLE_TILT_MIN            20
+#define PLATO_TABLE_TILT_STEP           2
+#define PLATO_TABLE_TILT_SIZE           31
+
+/* Temperature axis of the table, in °C. The correction of the firmware bends the gravity by about 1e-4 per °C²,
+   a 1 °C step keeps its interpolation error within PLATO_TABLE_ERROR_MAX. */
+#define PLATO_TABLE_TEMPERATURE_MIN     0
+#define PLATO_TABLE_TEMPERATURE_STEP    1
+#define PLATO_TABLE_TEMPERATURE_SIZE    31
+
+/** @brief Values are stored in 1/500 °P, range ±65 °P. */
+#define PLATO_TABLE_SCALE               500
+
+/** @brief Marks a value which has not been calculated yet. */
+#define PLATO_TABLE_EMPTY               INT16_MIN
+
+/** @brief Temperature passed when it is not known, the correction is skipped. */
+#define PLATO_TABLE_TEMPERATURE_ERROR   (-127)
+
+/** @brief Largest interpolation error of a cell in °P, the resolution of the stored measurement. */
+#define PLATO_TABLE_ERROR_MAX           0.01f
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief State of a cell of the table. */
+enum plato_table_cell
+{
+    PLATO_TABLE_CELL_UNCHECKED,     /**< The interpolation error has not been calculated yet. */
+    PLATO_TABLE_CELL_FINE,          /**< The interpolation error is within PLATO_TABLE_ERROR_MAX. */
+    PLATO_TABLE_CELL_COARSE         /**< The interpolation error exceeds PLATO_TABLE_ERROR_MAX, the exact formula is used. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Degrees Plato as a function of tilt and temperature, tabulated for the calibration coefficients.
+ *        The table is kept in RAM and filled lazily, a value is calculated with the exact formula
+ *        the first time a lookup needs it. Samples of a burst fall into a few cells, so a wake-up
+ *        calculates a few values instead of converting every sample.
+ *        The first lookup in a cell compares the interpolation with the exact formula in the middle
+ *        of the cell and of its edges, where the error of a smooth function peaks. A cell with
+ *        a larger error than PLATO_TABLE_ERROR_MAX is not interpolated.
+ */
+class PlatoTable
+{
+public:
+
+    /** @brief Construct a new Plato Table object, it cannot be used before init(). */
+    PlatoTable();
+
+    /**
+     * @brief Clears the table, values are calculated for the coefficients on demand.
+     * @param [in] coefficients - coefficients a to e of the tilt to gravity polynomial
+     */
+    void init(const float (&coefficients)[5]);
+
+    /**
+     * @brief Interpolates degrees Plato from the table.
+     * @param [in] tilt - tilt in degrees
+     * @param [in] temperature - temperature in °C
+     * @param [out] plato - degrees Plato
+     * @return true if successful, false if the table is not initialized, the arguments are out of its range
+     *         or the interpolation error of the cell exceeds PLATO_TABLE_ERROR_MAX.
+     */
+    bool lookup(float tilt, float temperature, float *plato);
+
+    /**
+     * @brief Get the largest interpolation error of the cells checked since init().
+     * @return float - error against the exact formula in °P, 0 if no cell has been checked
+     */
+    float get_error_max() const;
+
+    /**
+     * @brief Exact degrees Plato of the tilt and temperature.
+     * @param [in] coefficients - coefficients a to e of the tilt to gravity polynomial
+     * @param [in] tilt - tilt in degrees
+     * @param [in] temperature - temperature in °C, PLATO_TABLE_TEMPERATURE_ERROR skips the correction
+     * @return float - degrees Plato
+     */
+    static float calculate(const float (&coefficients)[5], float tilt, float temperature);
+
+private:
+
+    /** @brief Get the value at the grid point, it is calculated on the first access. */
+    int16_t value(size_t i, size_t j);
+
+    /** @brief Interpolates the value at the position u, v within the cell, both from 0 to 1. */
+    float interpolate(size_t i, size_t j, float u, float v);
+
+    /** @brief Checks whether the cell can be interpolated, its error is calculated on the first access. */
+    bool check(size_t i, size_t j);
+
+    float coefficients[5];                                                      /**< Coefficients the table is calculated for. */
+    int16_t values[PLATO_TABLE_TILT_SIZE][PLATO_TABLE_TEMPERATURE_SIZE];        /**< Degrees Plato in 1/PLATO_TABLE_SCALE, or PLATO_TABLE_EMPTY. */
+    uint8_t cells[PLATO_TABLE_TILT_SIZE - 1][PLATO_TABLE_TEMPERATURE_SIZE - 1]; /**< @see plato_table_cell, cell of the grid point i, j to i + 1, j + 1. */
+    float error_max;                                                            /**< Largest interpolation error of the checked cells, in °P. */
+    bool ready;                                                                 /**< Flag indicating the table can be used. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* PLATO_TABLE_H_ */
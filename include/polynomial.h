@@ -0,0 +1,101 @@
+/**
+ * @file polynomial.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef POLYNOMIAL_H_
+#define POLYNOMIAL_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/**
+ * @brief Signed Q16.16 fixed point number, range ±32768 with resolution 1/65536.
+ * @note  The ESP8266 has no FPU, integer multiplication replaces the software float routines.
+ */
+class q16_16
+{
+public:
+
+    constexpr q16_16() : raw(0) {}
+
+    /** @brief Conversion from a floating point value, rounded to the nearest step. */
+    constexpr q16_16(double value) : raw((int32_t)(value * 65536.0 + (value < 0 ? -0.5 : 0.5))) {}
+
+    explicit operator float() const { return raw / 65536.0f; }
+    explicit operator double() const { return raw / 65536.0; }
+
+    q16_16 operator+(q16_16 other) const { return from_raw(raw + other.raw); }
+    q16_16 operator-(q16_16 other) const { return from_raw(raw - other.raw); }
+
+    /** @brief Product rounded to the nearest step. */
+    q16_16 operator*(q16_16 other) const { return from_raw((int32_t)(((int64_t)raw * other.raw + 0x8000) >> 16)); }
+
+    static constexpr q16_16 from_raw(int32_t raw) { return q16_16(raw, 0); }
+
+    int32_t raw;    /**< Value multiplied by 65536. */
+
+private:
+
+    constexpr q16_16(int32_t raw, int) : raw(raw) {}
+};
+
+//--------------------------------------------------------------------------------
+/* Public functions definitions. */
+
+/**
+ * @brief Evaluates the polynomial in Horner form, one multiplication and one addition per coefficient.
+ * @param [in] coefficients - coefficients from the highest power to the constant term
+ * @param [in] x - argument
+ * @return T - value of the polynomial
+ */
+template <typename T, size_t N>
+inline T polynomial_evaluate(const T (&coefficients)[N], T x)
+{
+    T result = coefficients[0];
+
+    for (size_t i = 1; i < N; i++)
+        result = result * x + coefficients[i];
+
+    return result;
+}
+
+/**
+ * @brief Specific gravity correction factor for a hydrometer calibrated at 60 °F.
+ *        source : https://www.homebrewersassociation.org/attachments/0000/2497/Math_in_Mash_SummerZym95.pdf
+ * @note  The cubic term is below the Q16.16 resolution, float or double should be used.
+ *        The constants are those of the deployed firmware, stored readings depend on them.
+ * @param [in] fahrenheit - temperature in °F
+ * @return T - factor the gravity is multiplied by
+ */
+template <typename T>
+inline T gravity_temperature_correction(T fahrenheit)
+{
+    static constexpr T coefficients[] = {T(-2.32820948e-08), T(2.04052596e-05), T(-1.34722124e-03), T(1.00130346)};
+    return polynomial_evaluate(coefficients, fahrenheit);
+}
+
+/**
+ * @brief Degrees Plato of the specific gravity, Math in Mash SummerZym95 formula (7).
+ * @param [in] gravity - specific gravity
+ * @return T - degrees Plato
+ */
+template <typename T>
+inline T plato_from_gravity(T gravity)
+{
+    static constexpr T coefficients[] = {T(182.94), T(-776.43), T(1262.45), T(-668.962)};
+    return polynomial_evaluate(coefficients, gravity);
+}
+
+//--------------------------------------------------------------------------------
+
+#endif /* POLYNOMIAL_H_ */
@@ -0,0 +1,151 @@
+/**
+ * @file profiler.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//--------------------------------------------------------------------------------
+/* Current draw of the device in each phase, in mA, used to estimate the charge. */
+
+#define PROFILER_CURRENT_BATTERY        20
+#define PROFILER_CURRENT_CONFIG         25
+#define PROFILER_CURRENT_WIFI           80
+#define PROFILER_CURRENT_AUTH           80
+#define PROFILER_CURRENT_TEMPERATURE    25
+#define PROFILER_CURRENT_TILT           25
+#define PROFILER_CURRENT_FLASH          30
+#define PROFILER_CURRENT_UPLOAD         80
+#define PROFILER_CURRENT_SLEEP          20
+
+/** @brief Number of wake-ups summarized in a single upload. */
+#define PROFILER_SUMMARY_WAKES          24
+
+/** @brief Number of wake-ups after which a summary that could not be uploaded is dropped. */
+#define PROFILER_SUMMARY_WAKES_MAX      (4 * PROFILER_SUMMARY_WAKES)
+
+/** @brief Maximum number of nested spans. */
+#define PROFILER_DEPTH_MAX              4
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Phases of a wake-up. */
+enum profiler_phase
+{
+    PROFILER_PHASE_BATTERY,     /**< Battery check and voltage measurement. */
+    PROFILER_PHASE_CONFIG,      /**< Config load. */
+    PROFILER_PHASE_WIFI,        /**< WiFi connection. */
+    PROFILER_PHASE_AUTH,        /**< Firebase initialization and sign-in. */
+    PROFILER_PHASE_TEMPERATURE, /**< DS18B20 conversion. */
+    PROFILER_PHASE_TILT,        /**< Tilt sampling and conversion. */
+    PROFILER_PHASE_FLASH,       /**< Flash and RTC memory I/O of the measurements. */
+    PROFILER_PHASE_UPLOAD,      /**< Upload of the measurements. */
+    PROFILER_PHASE_SLEEP,       /**< Sleep entry. */
+    PROFILER_PHASE_COUNT
+};
+
+/** @brief Phase times summed over the wake-ups since the last upload, kept in RTC memory across deep sleep. */
+struct profiler_rtc
+{
+    uint32_t wakes;                         /**< Number of summarized wake-ups. */
+    uint32_t awake;                         /**< Total awake time in ms. */
+    uint32_t time[PROFILER_PHASE_COUNT];    /**< Total time of each phase in ms. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Measures the time of the phases of a wake-up with the CPU cycle counter.
+ *        Spans can be nested, the time of a nested span is not counted in the enclosing one.
+ */
+class Profiler
+{
+public:
+
+    /**
+     * @brief Get the static instance of Profiler.
+     * @return Profiler& - reference to the Profiler object
+     */
+    static Profiler& get_instance();
+
+    /** @brief Restores the summary of the previous wake-ups, must be called first in the wake-up. */
+    void init();
+
+    /**
+     * @brief Starts the span of the phase, the running span is paused until end().
+     * @param [in] phase - phase of the span
+     */
+    void begin(profiler_phase phase);
+
+    /** @brief Ends the last started span. */
+    void end();
+
+    /** @brief Adds this wake-up to the summary in RTC memory, called right before the deep sleep. */
+    void save();
+
+    /**
+     * @brief Checks whether the summary covers enough wake-ups to be uploaded.
+     * @return true if PROFILER_SUMMARY_WAKES were summarized, otherwise false.
+     */
+    bool is_summary_due();
+
+    /**
+     * @brief Get the summary of the previous wake-ups.
+     * @return const profiler_rtc& - summed times
+     */
+    const profiler_rtc &get_summary();
+
+    /** @brief Clears the summary after it was uploaded. */
+    void clear_summary();
+
+    /**
+     * @brief Get the time of the phase in this wake-up.
+     * @param [in] phase - phase
+     * @return uint32_t - time in us
+     */
+    uint32_t get_time(profiler_phase phase);
+
+    /**
+     * @brief Estimates the charge drawn during the time.
+     * @param [in] phase - phase, selects the current draw
+     * @param [in] time - time in us
+     * @return float - charge in uAh
+     */
+    static float get_charge(profiler_phase phase, uint32_t time);
+
+    /**
+     * @brief Get the name of the phase.
+     * @param [in] phase - phase
+     * @return const char* - name used in logs and in the database
+     */
+    static const char *get_phase_name(profiler_phase phase);
+
+private:
+
+    /**
+     * @brief Adds the cycles of the running span since it was started or resumed.
+     * @note  A single span must be shorter than the 32-bit cycle counter period, 53 s at 80 MHz.
+     */
+    void account();
+
+    static Profiler instance;                   /**< The only static profiler instance in the program. */
+    profiler_rtc summary;                       /**< Summary of the previous wake-ups. */
+    uint64_t cycles[PROFILER_PHASE_COUNT];      /**< CPU cycles of each phase in this wake-up. */
+    profiler_phase stack[PROFILER_DEPTH_MAX];   /**< Started spans, the last one is running. */
+    uint8_t depth;                              /**< Number of started spans. */
+    uint32_t start;                             /**< Cycle count when the running span was started or resumed. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,67 @@
+/**
+ * @file rtc_memory.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef RTC_MEMORY_H_
+#define RTC_MEMORY_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <coredecls.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief Size of the RTC user memory in bytes. */
+#define RTC_MEMORY_SIZE 512
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/**
+ * @brief Slots in the RTC user memory, offsets in 4-byte blocks.
+ *        Every slot is followed by one block with CRC32 of its content.
+ */
+enum rtc_memory_slot
+{
+    RTC_SLOT_OFFLINE_WAKE_COUNTER = 0,  /**< uint32_t, 1 + 1 blocks. */
+    RTC_SLOT_CLOCK                = 2,  /**< Clock kept across deep sleep, 4 + 1 blocks. */
+    RTC_SLOT_STAGING              = 7,  /**< Measurements waiting for the flash, 32 + 1 blocks. */
+    RTC_SLOT_CONFIG               = 40, /**< Settings needed on every wake-up, 28 + 1 blocks. */
+    RTC_SLOT_WIFI                 = 69, /**< Last WiFi connection, 7 + 1 blocks. */
+    RTC_SLOT_TEMP_SENSOR          = 77, /**< Temperature sensor ROM code and readings, 5 + 1 blocks. */
+    RTC_SLOT_ACCELGYRO            = 83, /**< Wake-on-motion state, 1 + 1 blocks. */
+    RTC_SLOT_PROFILER             = 85, /**< Phase times summed over the wake-ups, 11 + 1 blocks. */
+    RTC_SLOT_SCHEDULER            = 97, /**< Wake-up backoff state, 1 + 1 blocks. */
+    RTC_SLOT_SEQUENCE             = 99, /**< Sequence number of the next measurement, 1 + 1 blocks. */
+};
+
+//--------------------------------------------------------------------------------
+/* Public functions declarations. */
+
+/**
+ * @brief Reads the slot from the RTC user memory and verifies its CRC.
+ * @param [in] slot - slot to read
+ * @param [out] data - buffer for the slot content
+ * @param [in] size - size of the slot content in bytes
+ * @return true if the content is valid, otherwise false.
+ */
+bool rtc_memory_read(rtc_memory_slot slot, void *data, size_t size);
+
+/**
+ * @brief Writes the slot with its CRC to the RTC user memory.
+ * @param [in] slot - slot to write
+ * @param [in] data - slot content
+ * @param [in] size - size of the slot content in bytes
+ * @return true if successful, otherwise false.
+ */
+bool rtc_memory_write(rtc_memory_slot slot, const void *data, size_t size);
+
+//--------------------------------------------------------------------------------
+
+#endif /* RTC_MEMORY_H_ */
@@ -0,0 +1,48 @@
+/**
+ * @file scheduler.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief Largest offset of the wake-up from the sleep time grid, derived from the chip ID, in microseconds. */
+#define SCHEDULER_JITTER_MAX            60000000ULL
+
+/** @brief Backoff window after the first failed connection or upload, doubled on each next failure, in microseconds. */
+#define SCHEDULER_BACKOFF_BASE          30000000ULL
+
+/** @brief Maximum number of doublings of the backoff window, it never exceeds the sleep time either. */
+#define SCHEDULER_BACKOFF_EXP_MAX       5
+
+/** @brief Shortest sleep, a wake-up closer to the grid point moves to the next one, in microseconds. */
+#define SCHEDULER_SLEEP_MIN             10000000ULL
+
+//--------------------------------------------------------------------------------
+/* Public functions declarations. */
+
+/**
+ * @brief Schedules the next wake-up on the sleep time grid, shifted by the per-device offset
+ *        so a fleet does not connect at once, and delayed by a random backoff after failures.
+ * @param [in] now - time since epoch in microseconds, 0 (TIME_ERROR) if unknown, the grid is then not used
+ * @param [in] sleep_time - interval between wake-ups in microseconds
+ * @param [in] seed - per-device value the offset is derived from
+ * @param [in] failures - number of consecutive wake-ups with a failed connection or upload
+ * @param [in] random - random number, selects the delay within the backoff window
+ * @return uint64_t - sleep duration in microseconds
+ */
+uint64_t scheduler_sleep(uint64_t now, uint64_t sleep_time, uint32_t seed, uint8_t failures, uint32_t random);
+
+//--------------------------------------------------------------------------------
+
+#endif /* SCHEDULER_H_ */
@@ -16,28 +16,49 @@
 #include <Firebase_ESP_Client.h>
 #include "log_debug.h"
 #include "config_manager.h"
+#include "data_log.h"
+#include "data_staging.h"
+#include "profiler.h"
+#include "sender_protocol.h"
 
 //--------------------------------------------------------------------------------
 
-/** @brief Maximum number of measurement files stored in memory. */
-#define SENDER_DATA_FILES_MAX 1000
+/** @brief Path of the file with the cached Firebase auth token. */
+#define SENDER_TOKEN_PATH       "/token.bin"
+
+/** @brief Magic number of the cached token file, "TOKN". */
+#define SENDER_TOKEN_MAGIC      0x4E4B4F54
+
+/** @brief Maximum length of the cached ID token. */
+#define SENDER_TOKEN_ID_MAX     2048
+
+/** @brief Maximum length of the cached refresh token. */
+#define SENDER_TOKEN_REFRESH_MAX 1024
+
+/** @brief Maximum length of the cached user ID. */
+#define SENDER_TOKEN_UID_MAX    128
 
 //--------------------------------------------------------------------------------
-/* Public constants and types*/
+/* Public constants and types. */
 
-/** @brief Measurement data structure. */
-struct data
+/** @brief Header of the cached token file, followed by the ID token, refresh token and UID. */
+struct sender_token_header
 {
-    float temperature;      /**< Value of the measured temperature. */
-    float plato;            /**< Value of the measured degrees plato.*/
-    float battery_voltage;  /**< Value of the measured battery voltage. */
+    uint32_t magic;         /**< SENDER_TOKEN_MAGIC. */
+    uint32_t expires;       /**< Expiry time of the ID token since epoch. */
+    uint16_t id_size;       /**< Length of the ID token. */
+    uint16_t refresh_size;  /**< Length of the refresh token. */
+    uint16_t uid_size;      /**< Length of the user ID. */
+    uint16_t reserved;      /**< Padding. */
+    uint32_t crc;           /**< CRC32 of the fields above and the strings. */
 };
 
 //--------------------------------------------------------------------------------
 
 /** @brief Class for handling the Firebase database. 
  *         It is used to send measurements data and logs.
- *         When wifi is not connected, it saves measurements to flash memory.
+ *         When wifi is not connected, it stages measurements in the RTC user memory
+ *         and moves them to the log in flash memory when the staging buffer is full.
  */
 class Sender
 {
@@ -56,17 +77,37 @@ public:
     void init();
 
     /**
-     * @brief Send measurement data to the database, including data stored in files
-     * @param [in] measurement - Pointer to the structure with measurement data
+     * @brief Send measurement data to the database, including data stored in the log
+     * @param [in] measurement - Pointer to the structure with measurement data, nullptr sends only the stored data
+     * @return true if the measurement and the stored data were sent, false if the rest was left for the next wake-up
      */
-    void send_data(data *measurement);
+    bool send_data(data *measurement);
 
     /**
-     * @brief Save measurement data to a file
+     * @brief Save measurement data to the staging buffer, the buffer is moved to the log when full
      * @param [in] measurement - Reference to the structure with measurement data
      */
     void save_data(data &measurement);
 
+    /**
+     * @brief Get the number of TLS connections opened in this wake-up, each one costs a full handshake.
+     * @return uint32_t - number of connections
+     */
+    uint32_t get_handshake_count();
+
+    /**
+     * @brief Get the total time of requests which opened a new TLS connection, including the handshake.
+     * @return uint32_t - time in ms
+     */
+    uint32_t get_handshake_time();
+
+    /**
+     * @brief Send the profiler summary to the database, phase times and charge are averaged per wake-up.
+     * @param [in] summary - Phase times summed over the wake-ups
+     * @return true if the update was acknowledged by the database, otherwise false
+     */
+    bool send_profile(const profiler_rtc &summary);
+
 #if LOG_DEBUG == LOG_WIFI
     /**
      * @brief Send the log to the database
@@ -76,58 +117,70 @@ public:
 #endif
 private:
 
-    /** @brief Construct a new Sender object. */
-    Sender();
+    /** @brief Log, staging buffer and database of the sender, as used by sender_upload(). */
+    struct upload_link
+    {
+        Sender *sender;         /**< Sender of the upload. */
+        unsigned long start;    /**< Time the upload started, in ms. */
 
-    /**
-     * @brief Send the temperature measurement to the database
-     * @param [in] temp - Measured temperature to send
-     * @return true if sending was successful, otherwise false
-     */
-    bool send_temperature(float temp);
+        /** @brief Number of measurements in the log. */
+        uint32_t count();
 
-    /**
-     * @brief Send the measured degrees plato to the database
-     * @param plato  - Measured plato to send
-     * @return true if sending was successful, otherwise false
-     */
-    bool send_plato(float plato);
+        /** @brief Reads the oldest measurements of the log. */
+        size_t read(data *records, size_t max);
 
-    /**
-     * @brief Send the battery voltage measurement to the database
-     * @param voltage - Measured battery voltage to send
-     * @return true if sending was successful, otherwise false
-     */
-    bool send_battery_voltage(float voltage);
+        /** @brief Removes the acknowledged measurements from the log. */
+        void drop(size_t count);
+
+        /** @brief Saves the unsent measurement, @see save_data(). */
+        void save(const data &measurement);
+
+        /** @brief Sends a chunk, @see send_batch(). */
+        bool send(const data *records, size_t count);
+
+        /** @brief Time since the upload started, in ms. */
+        uint32_t elapsed();
+
+        /** @brief Logs the next attempt of a chunk. */
+        void retry(int attempt);
+    };
+
+    /** @brief Construct a new Sender object. */
+    Sender();
 
     /**
-     * @brief Send the given time to the database
-     * @param time - Time value to send
-     * @return true if sending was successful, otherwise false
+     * @brief Send a chunk of measurements to the database in a single multi-path update.
+     * @param [in] records - Pointer to the first measurement of the chunk
+     * @param [in] count - Number of measurements in the chunk
+     * @return true if the update was acknowledged by the database, otherwise false
      */
-    bool send_time(time_t time);
+    bool send_batch(const data *records, size_t count);
 
     /**
-     * @brief Retrieves the current time and sends it to the database
-     * @return true if sending was successful, otherwise false
+     * @brief Move staged measurements from the RTC user memory to the log in flash memory.
+     * @return true if the staging buffer is empty afterwards, otherwise false
      */
-    bool send_time();
+    bool flush_staging();
 
     /**
-     * @brief Parse files with previous saved measurements
-     * @param [out] data_array - Pointer to the vector of structures to which the data from files is written.
+     * @brief Restore the auth token saved by the previous online wake-up, if it is still valid.
+     * @param [out] uid - User ID the token belongs to
+     * @return true if the token was passed to Firebase, otherwise false
      */
-    void parse_data_files(std::vector <data> *data_vector);
+    bool load_token(String &uid);
 
     /**
-     * @brief  Checks if files with saved measurements exist.
-     * @return true if there are saved measurements, otherwise false.
+     * @brief Save the current auth token in flash memory, so the next wake-up skips the sign-in.
+     * @param [in] uid - User ID the token belongs to
+     * @param [in] expires - Expiry time of the token since epoch
      */
-    bool data_waiting_to_sent();
-    
+    void save_token(const String &uid, uint32_t expires);
+
     static Sender instance;     /**< The only static sender instance in the program*/
     bool initialized;           /**< Initialization status flag. */
     data *measurement;          /**< Pointer to the measurement data to be sent. */
+    DataLog *data_log;          /**< Pointer to the log with saved measurements. */
+    DataStaging *data_staging;  /**< Pointer to the staging buffer in the RTC user memory. */
     FB_RTDB *database;          /**< Pointer to the */
     FirebaseData *fbdo;         /**< Pointer to the FirebaseData. */    
     FirebaseAuth *auth;         /**< Pointer to the FirebaseAuth. */
@@ -137,8 +190,12 @@ private:
     char *api_key;          /**< Firebase API key. */
     char *database_url;     /**< URL to the database. */
     const char *uid;        /**< User ID. */
+    String token_uid;       /**< User ID of the current auth token. */
+    uint32_t token_crc;     /**< CRC32 of the saved ID token, used to detect a refresh. */
+    uint32_t handshake_count;   /**< Number of TLS connections opened in this wake-up. */
+    uint32_t handshake_time;    /**< Time of requests which opened a TLS connection, in ms. */
     String database_path;   /**< Main path in the database. */
-    String parent_path;     /**< Subpath for data. */
+    String profile_path;    /**< Path of the profiler summaries in the database. */
 
 #if LOG_DEBUG == LOG_WIFI
     bool is_path;           /**< Flag indicating whether the log path has been created. */
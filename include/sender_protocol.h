@@ -0,0 +1,210 @@
+/**
+ * @file sender_protocol.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef SENDER_PROTOCOL_H_
+#define SENDER_PROTOCOL_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "measurement_codec.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Maximum number of measurements sent in a single database update. */
+#define SENDER_BATCH_RECORDS_MAX 25
+
+/** @brief Maximum number of attempts to send a single batch. */
+#define SENDER_BATCH_ATTEMPTS_MAX 3
+
+/** @brief Time available for uploading in a single wake-up, in ms. */
+#define SENDER_UPLOAD_TIME_BUDGET 20000
+
+/** @brief Lifetime of the Firebase ID token, in seconds. */
+#define SENDER_TOKEN_LIFETIME   3600
+
+/** @brief Token closer to expiry than this is refreshed before use, in seconds. */
+#define SENDER_TOKEN_MARGIN     300
+
+/** @brief Prefix of the keys of measurements without time, they sort after the time ordered keys. */
+#define SENDER_UNTIMED_KEY_PREFIX "~"
+
+/** @brief Length of a push key. */
+#define SENDER_PUSH_KEY_SIZE    20
+
+/** @brief Size of a buffer for any measurement key, including the prefix and the terminator. */
+#define SENDER_KEY_BUF_SIZE     (sizeof(SENDER_UNTIMED_KEY_PREFIX) + SENDER_PUSH_KEY_SIZE)
+
+//--------------------------------------------------------------------------------
+/* Public functions declarations. */
+
+/**
+ * @brief Generates a chronologically ordered key in the same format as Firebase push().
+ * @param [in] time_ms - Time in milliseconds encoded in the key prefix
+ * @param [in] random - Source of the random part of the key, returns a value below its argument
+ * @param [out] key - Buffer for SENDER_PUSH_KEY_SIZE characters and the terminator
+ */
+void sender_push_key(uint64_t time_ms, long (*random)(long), char *key);
+
+/**
+ * @brief Generates the key of a measurement from its content, so every attempt to send it writes the same key
+ *        and an update applied by the database but not acknowledged is not stored twice when it is retried.
+ *        The key has the format of sender_push_key(), the time prefix is followed by a hash of the device ID
+ *        and the measurement in its fixed-point representation, which does not change in the log.
+ *        A measurement without time gets SENDER_UNTIMED_KEY_PREFIX and its sequence number as the prefix.
+ * @param [in] measurement - Measurement to send
+ * @param [in] device_id - ID of the device, keeps apart the keys of the devices of one user
+ * @param [in] timed - false if the time of the measurement is unknown
+ * @param [out] key - Buffer of SENDER_KEY_BUF_SIZE characters
+ */
+void sender_record_key(const data &measurement, uint32_t device_id, bool timed, char *key);
+
+/**
+ * @brief Get the lifetime left to a cached ID token. A token closer to expiry than SENDER_TOKEN_MARGIN
+ *        counts as expired, it is refreshed before use and not in the middle of the upload.
+ * @param [in] now - Current time since epoch, in seconds
+ * @param [in] expires - Expiry time of the token since epoch, in seconds
+ * @return uint32_t - Remaining lifetime in seconds, 0 if the token must be refreshed
+ */
+uint32_t sender_token_remaining(uint32_t now, uint32_t expires);
+
+/**
+ * @brief Checks whether the auth server rejected the token, e.g. INVALID_REFRESH_TOKEN or USER_DISABLED.
+ *        The token is then dropped and the next attempt signs in again, after a network error it is kept.
+ * @param [in] code - HTTP status of the auth request, network errors are negative
+ * @return true if the token was rejected, otherwise false
+ */
+bool sender_token_rejected(int code);
+
+//--------------------------------------------------------------------------------
+/* Public functions definitions. */
+
+/**
+ * @brief Adds the measurement to a multi-path update of the readings, the key is the same in all subpaths.
+ *        Used by the device with FirebaseJson and by the host tools with their own writer,
+ *        so both produce the same payload.
+ * @param [out] json - Update, any type with add(path, value)
+ * @param [in] key - Key of the measurement
+ * @param [in] measurement - Measurement to add
+ * @param [in] timed - false if the time of the measurement is unknown, the time subpath is then left out
+ */
+template <typename Json>
+void sender_batch_add(Json &json, const char *key, const data &measurement, bool timed)
+{
+    /* Longest subpath, "temperature/", the key and the terminator. */
+    char path[12 + SENDER_KEY_BUF_SIZE];
+
+    snprintf(path, sizeof(path), "temperature/%s", key);
+    json.add(path, measurement.temperature);
+    snprintf(path, sizeof(path), "plato/%s", key);
+    json.add(path, measurement.plato);
+    snprintf(path, sizeof(path), "voltage/%s", key);
+    json.add(path, measurement.battery_voltage);
+
+    if (timed)
+    {
+        snprintf(path, sizeof(path), "time/%s", key);
+        json.add(path, (int)measurement.time);
+    }
+}
+
+/**
+ * @brief Sends a chunk of measurements, a failed update is retried while the upload time budget lasts.
+ * @param [in,out] link - Database link, @see sender_upload()
+ * @param [in] records - Pointer to the first measurement of the chunk
+ * @param [in] count - Number of measurements in the chunk
+ * @return true if the update was acknowledged by the database, otherwise false
+ */
+template <typename Link>
+bool sender_batch_retry(Link &link, const data *records, size_t count)
+{
+    for (int attempt = 1; attempt <= SENDER_BATCH_ATTEMPTS_MAX; attempt++)
+    {
+        if (link.send(records, count))
+            return true;
+
+        if ((link.elapsed() >= SENDER_UPLOAD_TIME_BUDGET) || (attempt == SENDER_BATCH_ATTEMPTS_MAX))
+            break;
+
+        link.retry(attempt);
+    }
+
+    return false;
+}
+
+/**
+ * @brief Upload of a wake-up, used by Sender on the device and by HostSender on the host, so the host tools
+ *        measure the policy of the firmware. The backlog is drained oldest first in chunks of records_max,
+ *        the current measurement is sent with the last one. A chunk gets SENDER_BATCH_ATTEMPTS_MAX attempts,
+ *        only acknowledged chunks are dropped from the backlog and the upload stops when
+ *        SENDER_UPLOAD_TIME_BUDGET runs out. An unsent measurement is saved to the backlog.
+ * @param [in,out] link - Backlog and database, any type with:
+ *                        uint32_t count() - number of measurements in the backlog,
+ *                        size_t read(data *records, size_t max) - reads the oldest ones,
+ *                        void drop(size_t count) - removes the oldest ones,
+ *                        void save(const data &measurement) - appends the measurement,
+ *                        bool send(const data *records, size_t count) - sends a single update,
+ *                        uint32_t elapsed() - time since the upload started, in ms,
+ *                        void retry(int attempt) - called before the next attempt of a chunk
+ * @param [out] records - Buffer for a chunk
+ * @param [in] records_max - Size of the buffer, the maximum number of measurements in a single update
+ * @param [in] measurement - Current measurement, nullptr sends only the backlog
+ * @param [out] sent - Number of acknowledged measurements
+ * @return true if the measurement and the backlog were sent, false if the rest was left for the next wake-up
+ */
+template <typename Link>
+bool sender_upload(Link &link, data *records, size_t records_max, const data *measurement, uint32_t *sent)
+{
+    bool measurement_sent = false;
+
+    *sent = 0;
+
+    while (!measurement_sent)
+    {
+        if (link.elapsed() >= SENDER_UPLOAD_TIME_BUDGET)
+            break;
+
+        uint32_t backlog_size = link.count();
+        size_t saved = link.read(records, records_max);
+        size_t count = saved;
+        bool last_chunk = (saved == backlog_size) && (saved < records_max);
+
+        /* The log holds measurements, but none could be read. */
+        if ((saved == 0) && !last_chunk)
+            break;
+
+        if (last_chunk && (measurement != nullptr))
+            records[count++] = *measurement;
+
+        /* Nothing is left when only the backlog is drained. */
+        if (count == 0)
+        {
+            measurement_sent = true;
+            break;
+        }
+
+        if (!sender_batch_retry(link, records, count))
+            break;
+
+        link.drop(saved);
+        *sent += count;
+        measurement_sent = last_chunk;
+    }
+
+    if (!measurement_sent && (measurement != nullptr))
+        link.save(*measurement);
+
+    return measurement_sent;
+}
+
+//--------------------------------------------------------------------------------
+
+#endif /* SENDER_PROTOCOL_H_ */
@@ -15,12 +15,44 @@
 #include <OneWire.h>
 #include <DallasTemperature.h>
 #include "log_debug.h"
+#include "rtc_memory.h"
 
 //--------------------------------------------------------------------------------
 
 #define DS18B20_RESOLUTION (int)12
+#define DS18B20_RESOLUTION_LOW (int)9
 #define TEMPERATURE_OFFSET (-2)
 
+/** @brief Number of the last readings used to decide whether the temperature is stable. */
+#define DS18B20_HISTORY_SIZE 4
+
+/** @brief Maximum spread of the last readings for which the low resolution is used, in °C. */
+#define DS18B20_STABLE_THRESHOLD 0.5
+
+/** @brief Alarm band of the wort temperature, the full resolution is used near and outside of it, in °C. */
+#define TEMPERATURE_ALARM_LOW    5
+#define TEMPERATURE_ALARM_HIGH   25
+#define TEMPERATURE_ALARM_MARGIN 1
+
+/** @brief Additional time for the conversion before the result is read anyway, in ms. */
+#define DS18B20_CONVERSION_MARGIN 50
+
+/** @brief Function command starting the temperature conversion. */
+#define DS18B20_CONVERT_T 0x44
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Sensor found on the bus and its last readings, kept in RTC memory across deep sleep. */
+struct temp_sensor_rtc
+{
+    DeviceAddress address;                  /**< ROM code of the sensor. */
+    uint8_t parasite;                       /**< 1 if the sensor is parasite powered. */
+    uint8_t history_count;                  /**< Number of valid readings in the history. */
+    uint8_t reserved[2];                    /**< Padding. */
+    int16_t history[DS18B20_HISTORY_SIZE];  /**< The last raw readings in 1/16 °C, the newest first. */
+};
+
 //--------------------------------------------------------------------------------
 
 /** @brief Class for handling the DS18B20 temperature sensor. */
@@ -35,13 +67,14 @@ public:
     ~Temperature();
 
     /**
-     * @brief Sensor initialization and communication.
+     * @brief Sensor initialization and communication, starts the temperature conversion.
+     * @note  The conversion runs in the sensor, other work can be done until get_temp() is called.
      * @param [in] pin - Pin responsible for one wire communication.
      */
     void init(uint8_t pin);
 
     /**
-     * @brief Get the temperature measurement.
+     * @brief Get the temperature measurement, waits until the conversion started in init() is complete.
      * @return float - value of the measured temperature in degrees Celsius.
      */
     float get_temp();
@@ -51,10 +84,37 @@ public:
 
 private:
 
+    /**
+     * @brief Searches the bus for the sensor and caches its ROM code in RTC memory.
+     * @return true if the sensor was found, otherwise false.
+     */
+    bool find_sensor();
+
+    /**
+     * @brief Sets the resolution and starts the conversion on the sensor with the cached ROM code.
+     * @return true if the sensor responded with a valid scratchpad, otherwise false.
+     */
+    bool start_conversion();
+
+    /**
+     * @brief Chooses the resolution, the low one only when the last readings are stable and far from the alarm band.
+     * @return uint8_t - resolution in bits
+     */
+    uint8_t select_resolution();
+
+    /**
+     * @brief Adds the reading to the history and saves it in RTC memory.
+     * @param [in] temp - raw reading in degrees Celsius
+     */
+    void save_reading(float temp);
+
     bool initialized;               /**< Flag indicating sensor initialization status. */
     OneWire *one_wire;              /**< Pointer to OneWire responsible for communication */
     DallasTemperature *temp_sensor; /**< Pointer to dallasTemperature, responsible for low-level handling of the sensor. */
-    uint8_t device_address;         /**< Sensor address. */
+    temp_sensor_rtc cache;          /**< Sensor ROM code and the last readings. */
+    unsigned long conversion_start; /**< Time the conversion was started, in ms. */
+    uint16_t conversion_time;       /**< Conversion time for the set resolution, in ms. */
+    uint8_t resolution;             /**< Resolution of the current conversion, in bits. */
 };
 
 //--------------------------------------------------------------------------------
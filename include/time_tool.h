@@ -16,11 +16,24 @@
 #include <WiFiUdp.h>
 #include <ESP8266WiFi.h>
 #include <ctime>
+#include "rtc_memory.h"
 
 //--------------------------------------------------------------------------------
 
 #define TIME_ERROR 0
 
+/** @brief Shortest time between NTP synchronizations used to measure the drift of the deep sleep timer, in seconds. */
+#define TIME_DRIFT_WINDOW_MIN   600
+
+/** @brief Longest time between NTP synchronizations used to measure the drift, older clocks are not trusted, in seconds. */
+#define TIME_DRIFT_WINDOW_MAX   604800
+
+/** @brief Measured drift is averaged, each measurement moves the correction by 1/TIME_DRIFT_GAIN of its error. */
+#define TIME_DRIFT_GAIN         4
+
+/** @brief Limit of the drift correction, in ppm. */
+#define TIME_DRIFT_MAX          100000
+
 //--------------------------------------------------------------------------------
 /* Public functions declatarions. */
 
@@ -37,11 +50,31 @@ char* get_utc_time();
 char *get_utc_time_format_();
 
 /**
- * @brief Get the time since epoch
- * @return time_t - value of time since epoch
+ * @brief Get the time since epoch, synchronized with NTP or restored from RTC memory after deep sleep.
+ * @return time_t - value of time since epoch, TIME_ERROR if unknown
  */
 time_t get_time_since_epoch();
 
+/**
+ * @brief Checks whether the clock was synchronized with NTP in this wake-up.
+ * @return true if synchronized, otherwise false.
+ */
+bool time_is_synchronized();
+
+/**
+ * @brief Get the time since epoch with microsecond resolution.
+ * @return uint64_t - value of time since epoch in microseconds, TIME_ERROR if unknown
+ */
+uint64_t get_time_since_epoch_us();
+
+/**
+ * @brief Saves the clock in RTC memory, must be called right before deep sleep.
+ * @note  The deep sleep timer drift measured against NTP is compensated in the returned duration.
+ * @param [in] sleep_time - deep sleep duration in microseconds
+ * @return uint64_t - duration to pass to ESP.deepSleep(), in microseconds
+ */
+uint64_t time_prepare_sleep(uint64_t sleep_time);
+
 //--------------------------------------------------------------------------------
 
 #endif /* TIME_TOOL_H_ */
\ No newline at end of file
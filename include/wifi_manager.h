@@ -13,12 +13,36 @@
 //--------------------------------------------------------------------------------
 
 #include <ESP8266WiFi.h>
+#include "rtc_memory.h"
+#include "time_tool.h"
 
 //--------------------------------------------------------------------------------
 
 /** @brief Maximum waiting time for connecting to wifi. */
 #define WIFI_TIMEOUT 10000
 
+/** @brief Maximum waiting time for connecting to the cached access point, without scan and DHCP. */
+#define WIFI_FAST_TIMEOUT 3000
+
+/** @brief Lease time assumed when the DHCP server does not report one, in seconds. */
+#define WIFI_LEASE_TIME_DEFAULT 3600
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Last successful connection, kept in RTC memory to skip scan and DHCP after deep sleep. */
+struct wifi_rtc
+{
+    uint8_t bssid[6];   /**< MAC address of the access point. */
+    uint8_t channel;    /**< WiFi channel of the access point. */
+    uint8_t reserved;   /**< Padding. */
+    uint32_t ip;        /**< Address obtained from DHCP. */
+    uint32_t gateway;   /**< Gateway address. */
+    uint32_t subnet;    /**< Subnet mask. */
+    uint32_t dns;       /**< DNS server address. */
+    uint32_t renew;     /**< Time since epoch when the lease is due for renewal, the cache is not used afterwards. */
+};
+
 //--------------------------------------------------------------------------------
 
 /**
@@ -41,8 +65,32 @@ public:
      */
     bool is_connected();
 
+    /**
+     * @brief Get the time of the last connection attempt.
+     * @return uint32_t - time in ms
+     */
+    uint32_t get_connect_time();
+
+    /**
+     * @brief Drops the cached lease after IP traffic failed on a fast connection,
+     *        the address could be used by another host, the next wake-up asks DHCP again.
+     */
+    void drop_cached_lease();
+
 private:
 
+    /**
+     * @brief Connects to the access point cached in RTC memory with the previous DHCP lease.
+     * @return true if connected, otherwise false.
+     */
+    bool fast_connect();
+
+    /**
+     * @brief Connects with a full scan and DHCP, the connection is then cached in RTC memory.
+     * @return true if connected, otherwise false.
+     */
+    bool full_connect();
+
     /** 
      * @brief Wifi config load
      * @return  true if successful, otherwise false.
@@ -52,6 +100,8 @@ private:
     char *ssid;         /**< WiFi SSID */
     char *pass;         /**< WiFi password. */
     bool initialized;   /**< Flag indicating wifi initialization status. */
+    uint32_t connect_time;  /**< Duration of the last connection attempt in ms. */
+    bool fast_connected;    /**< Flag indicating the connection uses the cached lease. */
 };
 
 //--------------------------------------------------------------------------------
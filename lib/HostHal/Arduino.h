@@ -0,0 +1,180 @@
+/**
+ * @file Arduino.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_ARDUINO_H_
+#define HOST_ARDUINO_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+//--------------------------------------------------------------------------------
+
+/* Pins of the d1_mini. */
+#define D0          16
+#define D1          5
+#define D2          4
+#define D3          0
+#define D4          2
+#define D5          14
+#define D6          12
+#define D7          13
+#define D8          15
+#define A0          17
+
+#define HIGH        0x1
+#define LOW         0x0
+#define INPUT       0x00
+#define OUTPUT      0x01
+#define INPUT_PULLUP 0x02
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+static const uint8_t SDA = 4;
+static const uint8_t SCL = 5;
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief String of the Arduino core, numbers are formatted like the core does. */
+class String
+{
+public:
+
+    String(const char *value = "") : value(value ? value : "") {}
+    String(const std::string &value) : value(value) {}
+    explicit String(char value) : value(1, value) {}
+    explicit String(unsigned char value, unsigned char base = 10) : String((unsigned long)value, base) {}
+    explicit String(int value, unsigned char base = 10) : String((long)value, base) {}
+    explicit String(unsigned int value, unsigned char base = 10) : String((unsigned long)value, base) {}
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10) : String((long)value, base) {}
+    explicit String(unsigned long long value, unsigned char base = 10) : String((unsigned long)value, base) {}
+    explicit String(float value, unsigned char decimals = 2) : String((double)value, decimals) {}
+    explicit String(double value, unsigned char decimals = 2);
+
+    const char *c_str() const { return value.c_str(); }
+    unsigned int length() const { return value.size(); }
+    bool isEmpty() const { return value.empty(); }
+    void reserve(unsigned int size) { value.reserve(size); }
+    char charAt(unsigned int index) const { return (index < value.size()) ? value[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    int indexOf(char c) const { size_t i = value.find(c); return (i == std::string::npos) ? -1 : (int)i; }
+    String substring(unsigned int begin) const { return (begin < value.size()) ? String(value.substr(begin)) : String(); }
+    String substring(unsigned int begin, unsigned int end) const;
+    long toInt() const { return strtol(value.c_str(), NULL, 10); }
+    float toFloat() const { return strtof(value.c_str(), NULL); }
+    bool startsWith(const String &prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+
+    bool concat(const String &other) { value += other.value; return true; }
+    bool concat(const char *other) { value += other ? other : ""; return true; }
+    bool concat(char c) { value += c; return true; }
+
+    String &operator+=(const String &other) { concat(other); return *this; }
+    String &operator+=(const char *other) { concat(other); return *this; }
+    String &operator+=(char c) { concat(c); return *this; }
+
+    bool operator==(const String &other) const { return value == other.value; }
+    bool operator==(const char *other) const { return value == (other ? other : ""); }
+    bool operator!=(const String &other) const { return value != other.value; }
+    bool operator!=(const char *other) const { return !(*this == other); }
+    bool operator<(const String &other) const { return value < other.value; }
+
+private:
+
+    std::string value;  /**< Characters of the string. */
+};
+
+inline String operator+(const String &a, const String &b) { String s(a); s += b; return s; }
+inline String operator+(const String &a, const char *b) { String s(a); s += b; return s; }
+inline String operator+(const char *a, const String &b) { String s(a); s += b; return s; }
+inline String operator+(const String &a, char b) { String s(a); s += b; return s; }
+inline String operator+(const String &a, int b) { return a + String(b); }
+inline String operator+(const String &a, unsigned int b) { return a + String(b); }
+inline String operator+(const String &a, long b) { return a + String(b); }
+inline String operator+(const String &a, unsigned long b) { return a + String(b); }
+inline String operator+(const String &a, float b) { return a + String(b); }
+inline String operator+(const String &a, double b) { return a + String(b); }
+
+/** @brief Serial port, the output goes to the standard output of the wake-up process. */
+class HardwareSerial
+{
+public:
+
+    void begin(unsigned long baud) { (void)baud; }
+    void flush();
+    size_t print(const String &value);
+    size_t print(const char *value) { return print(String(value)); }
+    size_t print(char value) { return print(String(value)); }
+    size_t print(int value) { return print(String(value)); }
+    size_t print(unsigned int value) { return print(String(value)); }
+    size_t print(long value) { return print(String(value)); }
+    size_t print(unsigned long value) { return print(String(value)); }
+    size_t print(double value, int decimals = 2) { return print(String(value, decimals)); }
+    size_t println() { return print("\r\n"); }
+    template <typename T>
+    size_t println(const T &value) { return print(value) + println(); }
+};
+
+extern HardwareSerial Serial;
+
+//--------------------------------------------------------------------------------
+
+/** @brief Time since the start of the wake-up, in ms. */
+unsigned long millis();
+
+/** @brief Time since the start of the wake-up, in us. */
+unsigned long micros();
+
+/** @brief Time since the start of the wake-up, in us, without the overflow of micros(). */
+uint64_t micros64();
+
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+/** @brief Reads A0, the battery voltage through the divider of the d1_mini. */
+int analogRead(uint8_t pin);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+/** @brief Called once after the reset, defined by the firmware. */
+void setup(void);
+
+/** @brief Called repeatedly after setup(), defined by the firmware. */
+void loop(void);
+
+//--------------------------------------------------------------------------------
+
+#include <Esp.h>
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_ARDUINO_H_ */
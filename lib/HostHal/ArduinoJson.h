@@ -0,0 +1,126 @@
+/**
+ * @file ArduinoJson.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_ARDUINOJSON_H_
+#define HOST_ARDUINOJSON_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Value of ArduinoJson 5, as a string it is read only from a JSON string like the library does. */
+class JsonVariant
+{
+public:
+
+    /** @brief A string value, nullptr for other types. */
+    operator const char *() const { return (type == TYPE_STRING) ? text.c_str() : nullptr; }
+
+    JsonVariant &operator=(const char *value);
+    JsonVariant &operator=(char *value) { return *this = (const char *)value; }
+    JsonVariant &operator=(const String &value) { return *this = value.c_str(); }
+    JsonVariant &operator=(bool value);
+
+    template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    JsonVariant &operator=(T value)
+    {
+        set_number(std::is_floating_point<T>::value ? std::to_string((double)value) : std::to_string(value));
+        return *this;
+    }
+
+    bool success() const { return type != TYPE_UNDEFINED; }
+
+private:
+
+    friend class JsonObject;
+
+    /** @brief Type of the value. */
+    enum value_type
+    {
+        TYPE_UNDEFINED,     /**< Key without a value. */
+        TYPE_STRING,        /**< String, the text is unescaped. */
+        TYPE_LITERAL        /**< Number, true, false or null, the text as written in the JSON. */
+    };
+
+    void set_number(const std::string &value);
+
+    value_type type = TYPE_UNDEFINED;   /**< Type of the value. */
+    std::string text;                   /**< Text of the value. */
+};
+
+/** @brief Flat JSON object of ArduinoJson 5, the subset used by the config file. */
+class JsonObject
+{
+public:
+
+    bool success() const { return valid; }
+
+    /** @brief Value of the key, an undefined one is added when the key does not exist. */
+    JsonVariant &operator[](const char *key);
+
+    template <typename T>
+    size_t printTo(T &destination) const
+    {
+        std::string text = serialize();
+        return destination.write((const uint8_t *)text.data(), text.size());
+    }
+
+    /**
+     * @brief Parses an object of strings, numbers and literals, nested values are not supported.
+     * @param [in] json - JSON text
+     * @return true if the text is a valid object, otherwise false
+     */
+    bool parse(const char *json);
+
+    /** @brief Clears the object. */
+    void clear();
+
+private:
+
+    /** @brief JSON text of the object. */
+    std::string serialize() const;
+
+    bool valid = false;                                         /**< Whether the object was created or parsed. */
+    std::vector<std::pair<std::string, JsonVariant>> members;   /**< Keys and values in order. */
+};
+
+/** @brief Buffer of ArduinoJson 5, the capacity is not enforced on the host. */
+template <size_t CAPACITY>
+class StaticJsonBuffer
+{
+public:
+
+    JsonObject &parseObject(const char *json)
+    {
+        object.parse(json);
+        return object;
+    }
+
+    JsonObject &createObject()
+    {
+        object.clear();
+        object.parse("{}");
+        return object;
+    }
+
+private:
+
+    JsonObject object;  /**< The only object of the buffer. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_ARDUINOJSON_H_ */
@@ -0,0 +1,100 @@
+/**
+ * @file ESP8266WiFi.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_ESP8266WIFI_H_
+#define HOST_ESP8266WIFI_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+typedef enum
+{
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+} wl_status_t;
+
+typedef enum
+{
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} WiFiMode_t;
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Station of the ESP8266 core, connecting to the access point of host_device_config.
+ *        A connection takes its time only in waitForConnectResult(), it is lost when the network goes down.
+ */
+class ESP8266WiFiClass
+{
+public:
+
+    wl_status_t begin(const char *ssid, const char *password = nullptr, int32_t channel = 0,
+                      const uint8_t *bssid = nullptr, bool connect = true);
+    wl_status_t begin();
+    bool config(IPAddress local_ip, IPAddress gateway, IPAddress subnet, IPAddress dns1 = (uint32_t)0, IPAddress dns2 = (uint32_t)0);
+
+    /**
+     * @brief Waits until the connection succeeds or fails.
+     * @param [in] timeout - maximum wait, in ms
+     * @return int8_t - status, wl_status_t
+     */
+    int8_t waitForConnectResult(unsigned long timeout = 60000);
+
+    wl_status_t status();
+    bool isConnected();
+    bool disconnect(bool wifioff = false);
+    bool mode(WiFiMode_t mode);
+    bool persistent(bool persistent);
+    bool setAutoConnect(bool auto_connect);
+    bool forceSleepBegin(uint32_t sleep_us = 0);
+    bool forceSleepWake();
+
+    int32_t RSSI();
+    int32_t channel();
+    uint8_t *BSSID();
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t index = 0);
+
+private:
+
+    wl_status_t state = WL_IDLE_STATUS;     /**< Status of the station. */
+    bool started = false;                   /**< Whether a connection was started by begin(). */
+    bool static_ip = false;                 /**< Whether the address was set by config(). */
+    bool known_ap = false;                  /**< Whether begin() got the channel and BSSID. */
+    bool ap_matches = false;                /**< Whether the channel and BSSID are the ones of the access point. */
+    bool credentials = false;               /**< Whether the SSID and password are the ones of the access point. */
+    bool ssid_matches = false;              /**< Whether the SSID is the one of the access point. */
+    IPAddress ip;                           /**< Address of the station. */
+    IPAddress gateway;                      /**< Gateway. */
+    IPAddress subnet;                       /**< Subnet mask. */
+    IPAddress dns;                          /**< DNS server. */
+};
+
+extern ESP8266WiFiClass WiFi;
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_ESP8266WIFI_H_ */
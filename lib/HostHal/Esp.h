@@ -0,0 +1,90 @@
+/**
+ * @file Esp.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_ESP_H_
+#define HOST_ESP_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Radio mode after a deep sleep. */
+enum RFMode
+{
+    RF_DEFAULT = 0,
+    RF_CAL = 1,
+    RF_NO_CAL = 2,
+    RF_DISABLED = 4
+};
+
+/** @brief Reason of the last reset, from the SDK. */
+enum rst_reason
+{
+    REASON_DEFAULT_RST = 0,     /**< Power-up. */
+    REASON_WDT_RST = 1,
+    REASON_EXCEPTION_RST = 2,
+    REASON_SOFT_WDT_RST = 3,
+    REASON_SOFT_RESTART = 4,
+    REASON_DEEP_SLEEP_AWAKE = 5,
+    REASON_EXT_SYS_RST = 6
+};
+
+/** @brief Information about the last reset, from the SDK. */
+struct rst_info
+{
+    uint32_t reason;
+    uint32_t exccause;
+    uint32_t epc1;
+    uint32_t epc2;
+    uint32_t epc3;
+    uint32_t excvaddr;
+    uint32_t depc;
+};
+
+/** @brief Chip functions of the ESP8266 core, backed by the state of the simulated device. */
+class EspClass
+{
+public:
+
+    /**
+     * @brief Reads the RTC user memory, it survives deep sleep.
+     * @param [in] offset - offset in 4 byte blocks
+     * @return false if the range is out of the 512 bytes of the memory
+     */
+    bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size);
+
+    /**
+     * @brief Writes the RTC user memory.
+     * @param [in] offset - offset in 4 byte blocks
+     * @return false if the range is out of the 512 bytes of the memory
+     */
+    bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size);
+
+    /** @brief Ends the wake-up process, the simulator wakes the device up after the time. Never returns. */
+    [[noreturn]] void deepSleep(uint64_t time_us, RFMode mode = RF_DEFAULT);
+    [[noreturn]] void deepSleepInstant(uint64_t time_us, RFMode mode = RF_DEFAULT);
+    uint64_t deepSleepMax();
+
+    String getResetReason();
+    struct rst_info *getResetInfoPtr();
+    uint32_t getChipId();
+    uint32_t getCycleCount();
+    uint8_t getCpuFreqMHz();
+    uint32_t getFreeHeap();
+    uint32_t random();
+};
+
+extern EspClass ESP;
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_ESP_H_ */
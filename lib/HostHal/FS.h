@@ -0,0 +1,116 @@
+/**
+ * @file FS.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_FS_H_
+#define HOST_FS_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief Time of opening a file, the metadata lookup of LittleFS, in us. */
+#define HOST_FLASH_OPEN_TIME        1000
+
+/** @brief Read throughput of the flash, in bytes per ms. */
+#define HOST_FLASH_READ_RATE        4000
+
+/** @brief Write throughput of the flash including the erase, in bytes per ms. */
+#define HOST_FLASH_WRITE_RATE       100
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+enum SeekMode
+{
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+namespace fs
+{
+
+class FS;
+
+/** @brief Open file, a copy refers to the same file but keeps its own position. */
+class File
+{
+public:
+
+    File() {}
+    File(FS *fs, int id, bool writable) : fs(fs), id(id), writable(writable) {}
+
+    operator bool() const { return fs != nullptr; }
+    size_t size() const;
+    size_t position() const { return offset; }
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    bool truncate(uint32_t size);
+    size_t read(uint8_t *buffer, size_t size);
+    size_t readBytes(char *buffer, size_t length) { return read((uint8_t *)buffer, length); }
+    size_t write(const uint8_t *buffer, size_t size);
+    size_t write(uint8_t c) { return write(&c, 1); }
+    size_t print(const String &value) { return write((const uint8_t *)value.c_str(), value.length()); }
+    void flush() {}
+    void close();
+
+private:
+
+    FS *fs = nullptr;       /**< File system of the file, nullptr if the file is not open. */
+    int id = -1;            /**< Index of the file in host_flash. */
+    size_t offset = 0;      /**< Position in the file. */
+    bool writable = false;  /**< Whether the file was opened for writing. */
+};
+
+/**
+ * @brief File system of the ESP8266 core. LittleFS keeps its files in host_flash of the simulated device,
+ *        a file system without a partition cannot be mounted.
+ */
+class FS
+{
+public:
+
+    FS(bool partition) : partition(partition) {}
+
+    bool begin();
+    void end();
+    bool format();
+
+    /**
+     * @brief Opens the file.
+     * @param [in] path - absolute path
+     * @param [in] mode - "r", "r+", "w", "w+", "a" or "a+" like fopen()
+     * @return File - open file, false on error
+     */
+    File open(const char *path, const char *mode);
+    File open(const String &path, const char *mode) { return open(path.c_str(), mode); }
+    bool exists(const char *path);
+    bool exists(const String &path) { return exists(path.c_str()); }
+    bool remove(const char *path);
+    bool remove(const String &path) { return remove(path.c_str()); }
+    bool rename(const char *from, const char *to);
+
+private:
+
+    bool partition;         /**< Whether the file system has a partition in the flash. */
+    bool mounted = false;   /**< Whether begin() mounted the file system. */
+};
+
+} /* namespace fs */
+
+using fs::File;
+using fs::FS;
+
+/** @brief SPIFFS has no partition in the LittleFS layout of the firmware. */
+extern fs::FS SPIFFS;
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_FS_H_ */
@@ -0,0 +1,219 @@
+/**
+ * @file Firebase_ESP_Client.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_FIREBASE_ESP_CLIENT_H_
+#define HOST_FIREBASE_ESP_CLIENT_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <FS.h>
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------------------------
+
+/** @brief Lifetime of the ID tokens issued by the auth endpoints, in seconds. */
+#define HOST_FIREBASE_TOKEN_LIFETIME    3600
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief String of the Firebase library. */
+class MB_String
+{
+public:
+
+    MB_String &operator=(const char *value) { text = value ? value : ""; return *this; }
+    MB_String &operator=(const std::string &value) { text = value; return *this; }
+    bool operator==(const char *other) const { return text == other; }
+    const char *c_str() const { return text.c_str(); }
+    size_t length() const { return text.size(); }
+
+private:
+
+    std::string text;   /**< Characters of the string. */
+};
+
+/** @brief JSON object of an update, the keys are the subpaths of a multi-path update. */
+class FirebaseJson
+{
+public:
+
+    FirebaseJson &add(const String &key, float value);
+    FirebaseJson &add(const String &key, double value);
+    FirebaseJson &add(const String &key, int value);
+    FirebaseJson &add(const String &key, bool value);
+    FirebaseJson &add(const String &key, const String &value);
+    FirebaseJson &add(const String &key, const char *value) { return add(key, String(value)); }
+    FirebaseJson &clear() { body.clear(); return *this; }
+    bool toString(String &buffer, bool prettify = false) const;
+
+private:
+
+    /** @brief Appends the member with the value already written as JSON. */
+    FirebaseJson &append(const String &key, const std::string &value);
+
+    std::string body;   /**< Members without the braces. */
+};
+
+/** @brief JSON array. */
+class FirebaseJsonArray
+{
+public:
+
+    FirebaseJsonArray &add(const String &value);
+    size_t size() const { return values.size(); }
+    const String &get(size_t index) const { return values[index]; }
+
+private:
+
+    std::vector<String> values;     /**< Elements. */
+};
+
+/** @brief Connection to the database and the result of the last request on it. */
+class FirebaseData
+{
+public:
+
+    void setResponseSize(size_t size) { (void)size; }
+    void setBSSLBufferSize(uint16_t rx, uint16_t tx) { (void)rx; (void)tx; }
+    void stopWiFiClient() { connected = false; }
+    bool httpConnected() const { return connected; }
+    int httpCode() const { return code; }
+    String errorReason() const { return reason; }
+
+private:
+
+    friend class FB_RTDB;
+
+    bool connected = false;     /**< Whether the keep-alive connection is open. */
+    int code = 0;               /**< HTTP status of the last request, negative for the connection errors. */
+    String reason;              /**< Error of the last request. */
+};
+
+enum fb_esp_auth_token_status
+{
+    token_status_uninitialized,
+    token_status_on_signing,
+    token_status_on_request,
+    token_status_on_refresh,
+    token_status_ready,
+    token_status_error
+};
+
+/** @brief Error of the last auth request. */
+struct FirebaseAuthError
+{
+    MB_String message;  /**< Message of the error. */
+    int code;           /**< HTTP status code of the answer, negative for the connection errors. */
+};
+
+/** @brief Status of the ID token. */
+struct TokenInfo
+{
+    int type;                           /**< Type of the token. */
+    fb_esp_auth_token_status status;    /**< Status of the token. */
+    FirebaseAuthError error;            /**< Error of the last auth request. */
+};
+
+/** @brief Credentials of the user. */
+struct FirebaseAuth
+{
+    struct
+    {
+        MB_String email;
+        MB_String password;
+    } user;
+
+    struct
+    {
+        MB_String uid;
+    } token;
+};
+
+/** @brief Configuration of the client. */
+struct FirebaseConfig
+{
+    MB_String api_key;
+    MB_String database_url;
+    void (*token_status_callback)(TokenInfo) = nullptr;
+};
+
+/** @brief Realtime Database client, the requests go to the RtdbStandIn of the simulator. */
+class FB_RTDB
+{
+public:
+
+    /**
+     * @brief Applies the multi-path update without the echo of the written data (print=silent).
+     * @return true if the update was applied, otherwise false
+     */
+    bool updateNodeSilent(FirebaseData *fbdo, const String &path, FirebaseJson *json);
+
+    /** @brief Writes the array, its elements are the children 0, 1, ... of the path. */
+    bool setArray(FirebaseData *fbdo, const String &path, FirebaseJsonArray *array);
+
+    void setMaxRetry(FirebaseData *fbdo, uint8_t retry) { (void)fbdo; (void)retry; }
+    void runTask() {}
+
+private:
+
+    /** @brief Sends the update with the ID token, the request needs a ready token. */
+    bool update(FirebaseData *fbdo, const String &path, const std::string &body);
+};
+
+/**
+ * @brief Auth state of the Firebase library. A user signs in with begin(), an expired token is refreshed by ready().
+ *        The auth endpoints are on another host, every exchange opens its own connection.
+ */
+class FirebaseClass
+{
+public:
+
+    FB_RTDB RTDB;   /**< Realtime Database client. */
+
+    void begin(FirebaseConfig *config, FirebaseAuth *auth);
+    void reconnectWiFi(bool reconnect) { (void)reconnect; }
+
+    /**
+     * @brief Checks the ID token, an expired one is refreshed or the user signs in again.
+     * @return true if the token can be used, otherwise false
+     */
+    bool ready();
+    bool authenticated() const { return !token.empty(); }
+    bool isTokenExpired();
+
+    /**
+     * @brief Sets the token of a previous sign-in.
+     * @param [in] expire - remaining lifetime of the token, in seconds, 0 for a token to refresh
+     */
+    void setIdToken(FirebaseConfig *config, const char *id_token, size_t expire = 3600, const char *refresh_token = "");
+    void refreshToken(FirebaseConfig *config);
+    const char *getToken() const { return token.c_str(); }
+    const char *getRefreshToken() const { return refresh_token.c_str(); }
+    TokenInfo authTokenInfo() const { return info; }
+
+private:
+
+    /** @brief Signs in with the email and password, or exchanges the refresh token, depending on what is known. */
+    bool authenticate();
+
+    FirebaseAuth *auth = nullptr;   /**< Credentials and the user ID. */
+    std::string token;              /**< ID token. */
+    std::string refresh_token;      /**< Refresh token. */
+    uint64_t expires = 0;           /**< Expiry time of the ID token, in us since epoch. */
+    TokenInfo info = {0, token_status_uninitialized, {MB_String(), 0}};    /**< Status of the token. */
+};
+
+extern FirebaseClass Firebase;
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_FIREBASE_ESP_CLIENT_H_ */
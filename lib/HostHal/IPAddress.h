@@ -0,0 +1,39 @@
+/**
+ * @file IPAddress.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_IPADDRESS_H_
+#define HOST_IPADDRESS_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief IPv4 address, stored in the network byte order like the ESP8266 core does. */
+class IPAddress
+{
+public:
+
+    IPAddress() : address(0) {}
+    IPAddress(uint32_t address) : address(address) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : address((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+
+    operator uint32_t() const { return address; }
+    bool isSet() const { return address != 0; }
+
+private:
+
+    uint32_t address;   /**< Address, the first octet in the lowest byte. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_IPADDRESS_H_ */
@@ -0,0 +1,24 @@
+/**
+ * @file LittleFS.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_LITTLEFS_H_
+#define HOST_LITTLEFS_H_
+
+//--------------------------------------------------------------------------------
+
+#include <FS.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief LittleFS partition of the flash. */
+extern fs::FS LittleFS;
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_LITTLEFS_H_ */
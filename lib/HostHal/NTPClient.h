@@ -0,0 +1,57 @@
+/**
+ * @file NTPClient.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_NTPCLIENT_H_
+#define HOST_NTPCLIENT_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief Round trip of an NTP request, in ms. */
+#define HOST_NTP_TIME       40
+
+/** @brief Time NTPClient waits for an answer which does not come, in ms. */
+#define HOST_NTP_TIMEOUT    1000
+
+//--------------------------------------------------------------------------------
+
+/** @brief NTP client of the NTPClient library, the server answers with the time of the simulator. */
+class NTPClient
+{
+public:
+
+    NTPClient(WiFiUDP &udp, const char *server, long offset = 0, unsigned long interval = 60000);
+
+    void begin();
+    void end();
+
+    /**
+     * @brief Synchronizes the time when the update interval has passed since the last synchronization.
+     * @return true if the time is synchronized, otherwise false
+     */
+    bool update();
+    bool forceUpdate();
+    bool isTimeSet() const;
+    unsigned long getEpochTime() const;
+
+private:
+
+    long offset;                /**< Offset of the time zone, in seconds. */
+    unsigned long interval;     /**< Update interval, in ms. */
+    unsigned long epoch;        /**< Time since epoch at the last synchronization, in seconds. */
+    unsigned long update_time;  /**< millis() at the last synchronization, 0 if none. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_NTPCLIENT_H_ */
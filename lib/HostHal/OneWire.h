@@ -0,0 +1,83 @@
+/**
+ * @file OneWire.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_ONEWIRE_H_
+#define HOST_ONEWIRE_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief 1-Wire master of the OneWire library. The bus has a single DS18B20 on external power,
+ *        every slot takes the time of the standard speed.
+ */
+class OneWire
+{
+public:
+
+    OneWire() {}
+    OneWire(uint8_t pin) { begin(pin); }
+    void begin(uint8_t pin);
+
+    /**
+     * @brief Resets the bus, all devices wait for a ROM command.
+     * @return uint8_t - 1 if a device answered with a presence pulse, otherwise 0
+     */
+    uint8_t reset();
+    void select(const uint8_t rom[8]);
+    void skip();
+    void write(uint8_t value, uint8_t power = 0);
+    void write_bytes(const uint8_t *buffer, uint16_t count, bool power = 0);
+    uint8_t read();
+    void read_bytes(uint8_t *buffer, uint16_t count);
+    void write_bit(uint8_t value);
+    uint8_t read_bit();
+    void depower();
+
+    void reset_search();
+    void target_search(uint8_t family);
+
+    /**
+     * @brief Finds the next device on the bus.
+     * @param [out] rom - ROM code of the device
+     * @return true if a device was found, false when all were found
+     */
+    bool search(uint8_t *rom, bool search_mode = true);
+
+    /** @brief Dallas CRC-8, polynomial x^8 + x^5 + x^4 + 1. */
+    static uint8_t crc8(const uint8_t *addr, uint8_t len);
+
+private:
+
+    /** @brief Stage of the transaction since the last reset. */
+    enum stage
+    {
+        STAGE_IDLE,             /**< No reset yet, the devices ignore the bus. */
+        STAGE_ROM_COMMAND,      /**< Waiting for a ROM command. */
+        STAGE_FUNCTION,         /**< Waiting for a function command of the selected device. */
+        STAGE_WRITE_SCRATCHPAD, /**< Receiving TH, TL and the configuration. */
+        STAGE_READ_SCRATCHPAD,  /**< Sending the scratchpad. */
+        STAGE_READ_POWER,       /**< Sending the power supply mode. */
+        STAGE_DESELECTED        /**< The device was not selected, it waits for the next reset. */
+    };
+
+    /** @brief Executes a function command of the DS18B20. */
+    void command(uint8_t value);
+
+    stage state = STAGE_IDLE;   /**< Stage of the transaction. */
+    uint8_t index = 0;          /**< Next byte of the scratchpad read or written. */
+    bool searched = false;      /**< Whether the search has already returned the device. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_ONEWIRE_H_ */
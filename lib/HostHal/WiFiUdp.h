@@ -0,0 +1,22 @@
+/**
+ * @file WiFiUdp.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_WIFIUDP_H_
+#define HOST_WIFIUDP_H_
+
+//--------------------------------------------------------------------------------
+
+/** @brief UDP socket, NTPClient of the host does not send packets through it. */
+class WiFiUDP
+{
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_WIFIUDP_H_ */
@@ -0,0 +1,82 @@
+/**
+ * @file Wire.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_WIRE_H_
+#define HOST_WIRE_H_
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+
+//--------------------------------------------------------------------------------
+
+#define BUFFER_LENGTH   128
+
+/* Bus status of the ESP8266 core. */
+#define I2C_OK                      0
+#define I2C_SCL_HELD_LOW            1
+#define I2C_SCL_HELD_LOW_AFTER_READ 2
+#define I2C_SDA_HELD_LOW            3
+#define I2C_SDA_HELD_LOW_AFTER_INIT 4
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief I2C master of the ESP8266 core. The bus has the MPU6050 at 0x68, the transfers take the time
+ *        of their bits at the bus clock.
+ */
+class TwoWire
+{
+public:
+
+    void begin(int sda, int scl);
+    void begin();
+    uint8_t status();
+    void setClock(uint32_t frequency);
+    void setClockStretchLimit(uint32_t limit);
+
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+
+    /**
+     * @brief Sends the buffered bytes to the device.
+     * @return uint8_t - 0 if successful, 2 if the address was not acknowledged, 4 on other errors
+     */
+    uint8_t endTransmission(uint8_t send_stop = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+
+    /**
+     * @brief Reads the bytes from the device into the receive buffer.
+     * @return uint8_t - number of bytes received
+     */
+    uint8_t requestFrom(uint8_t address, size_t size, bool send_stop);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity);
+    uint8_t requestFrom(int address, int quantity);
+
+    int available();
+    int read();
+    int peek();
+
+private:
+
+    uint32_t frequency = 100000;        /**< Clock of the bus, in Hz. */
+    uint8_t address = 0;                /**< Address of the transmission. */
+    uint8_t tx[BUFFER_LENGTH];          /**< Transmit buffer. */
+    size_t tx_length = 0;               /**< Bytes in the transmit buffer. */
+    uint8_t rx[BUFFER_LENGTH];          /**< Receive buffer. */
+    size_t rx_length = 0;               /**< Bytes in the receive buffer. */
+    size_t rx_index = 0;                /**< Next byte of the receive buffer. */
+};
+
+extern TwoWire Wire;
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_WIRE_H_ */
@@ -0,0 +1,32 @@
+/**
+ * @file coredecls.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_COREDECLS_H_
+#define HOST_COREDECLS_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief CRC-32 of the ESP8266 core, polynomial 0x04C11DB7, MSB first and without the final XOR,
+ *        so a CRC of several buffers is computed by passing the previous result.
+ * @param [in] data - buffer
+ * @param [in] length - size of the buffer
+ * @param [in] crc - initial value
+ * @return uint32_t - CRC
+ */
+uint32_t crc32(const void *data, size_t length, uint32_t crc = 0xffffffff);
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_COREDECLS_H_ */
@@ -0,0 +1,334 @@
+/**
+ * @file host_arduino.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <unistd.h>
+#include <Arduino.h>
+#include <coredecls.h>
+#include "host_hal.h"
+
+//--------------------------------------------------------------------------------
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+/** @brief Time of a call reading the clock, so busy waits on the clock advance the time, in us. */
+#define HOST_CLOCK_READ_TIME        1
+
+/** @brief Time of yield(), the system tasks of the core, in us. */
+#define HOST_YIELD_TIME             10
+
+/** @brief Time of an ADC conversion, in us. */
+#define HOST_ADC_TIME               100
+
+/** @brief ADC counts per volt of the battery, the divider of the hydrometer board in front of A0. */
+#define HOST_ADC_COUNTS_PER_VOLT    171.39f
+
+/** @brief Longest deep sleep the ESP8266 timer supports, in us. */
+#define HOST_DEEP_SLEEP_MAX         12000000000ULL
+
+/** @brief Clock of the CPU, in MHz. */
+#define HOST_CPU_FREQ_MHZ           80
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+static const char *reset_reasons[] = {"Power On", "Hardware Watchdog", "Exception", "Software Watchdog",
+                                      "Software/System restart", "Deep-Sleep Wake", "External System"};
+
+HardwareSerial Serial;
+EspClass ESP;
+
+//--------------------------------------------------------------------------------
+
+String::String(long value, unsigned char base)
+{
+    if (base == 10)
+    {
+        this->value = std::to_string(value);
+        return;
+    }
+
+    if (value < 0)
+        *this = "-" + String((unsigned long)-value, base);
+    else
+        *this = String((unsigned long)value, base);
+}
+
+String::String(unsigned long value, unsigned char base)
+{
+    char buf[8 * sizeof(value) + 1];
+    char *p = &buf[sizeof(buf) - 1];
+
+    if (base < 2)
+        base = 10;
+
+    *p = '\0';
+    do
+    {
+        uint8_t digit = value % base;
+        *--p = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+        value /= base;
+    } while (value > 0);
+
+    this->value = p;
+}
+
+String::String(double value, unsigned char decimals)
+{
+    char buf[64];
+
+    /* dtostrf() of the core. */
+    snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+    this->value = buf;
+}
+
+String String::substring(unsigned int begin, unsigned int end) const
+{
+    if (begin > end)
+        std::swap(begin, end);
+
+    if (begin >= value.size())
+        return String();
+
+    return String(value.substr(begin, std::min<size_t>(end, value.size()) - begin));
+}
+
+void HardwareSerial::flush()
+{
+    fflush(stdout);
+}
+
+size_t HardwareSerial::print(const String &value)
+{
+    return fwrite(value.c_str(), 1, value.length(), stdout);
+}
+
+//--------------------------------------------------------------------------------
+
+unsigned long millis()
+{
+    return micros64() / 1000;
+}
+
+unsigned long micros()
+{
+    return (uint32_t)micros64();
+}
+
+uint64_t micros64()
+{
+    host_advance(HOST_CLOCK_READ_TIME);
+    return host_awake_time();
+}
+
+void delay(unsigned long ms)
+{
+    host_advance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    host_advance(us);
+}
+
+void yield()
+{
+    host_advance(HOST_YIELD_TIME);
+}
+
+long random(long max)
+{
+    return (max > 0) ? (long)(host_random() % (uint32_t)max) : 0;
+}
+
+long random(long min, long max)
+{
+    return (max > min) ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed)
+{
+    (void)seed;
+}
+
+int analogRead(uint8_t pin)
+{
+    host_advance(HOST_ADC_TIME);
+
+    if (pin != A0)
+        return 0;
+
+    /* The ADC has 10 bits and about one count of noise. */
+    float counts = host_config->environment.battery(host->time) * HOST_ADC_COUNTS_PER_VOLT + host_random_normal();
+    return constrain((int)lroundf(counts), 0, 1023);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    (void)pin;
+    (void)value;
+}
+
+int digitalRead(uint8_t pin)
+{
+    (void)pin;
+    return HIGH;
+}
+
+uint32_t crc32(const void *data, size_t length, uint32_t crc)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    while (length--)
+    {
+        uint8_t c = *bytes++;
+
+        for (uint32_t i = 0x80; i > 0; i >>= 1)
+        {
+            bool bit = crc & 0x80000000;
+
+            if (c & i)
+                bit = !bit;
+
+            crc <<= 1;
+            if (bit)
+                crc ^= 0x04c11db7;
+        }
+    }
+
+    return crc;
+}
+
+//--------------------------------------------------------------------------------
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size)
+{
+    if ((offset * 4 + size > HOST_RTC_MEMORY_SIZE) || (size == 0))
+        return false;
+
+    memcpy(data, &host->rtc_memory[offset * 4], size);
+    return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size)
+{
+    if ((offset * 4 + size > HOST_RTC_MEMORY_SIZE) || (size == 0))
+        return false;
+
+    memcpy(&host->rtc_memory[offset * 4], data, size);
+    return true;
+}
+
+void EspClass::deepSleep(uint64_t time_us, RFMode mode)
+{
+    host->sleep = time_us;
+    host->rf_mode = mode;
+
+    /* The wake-up process ends here, the simulator continues with the next one. */
+    fflush(stdout);
+    _exit(HOST_EXIT_SLEEP);
+}
+
+void EspClass::deepSleepInstant(uint64_t time_us, RFMode mode)
+{
+    deepSleep(time_us, mode);
+}
+
+uint64_t EspClass::deepSleepMax()
+{
+    return HOST_DEEP_SLEEP_MAX;
+}
+
+String EspClass::getResetReason()
+{
+    if (host->reset_reason >= sizeof(reset_reasons) / sizeof(reset_reasons[0]))
+        return String("Unknown");
+
+    return String(reset_reasons[host->reset_reason]);
+}
+
+struct rst_info *EspClass::getResetInfoPtr()
+{
+    static rst_info info;
+
+    memset(&info, 0, sizeof(info));
+    info.reason = host->reset_reason;
+    return &info;
+}
+
+uint32_t EspClass::getChipId()
+{
+    return host_config->chip_id;
+}
+
+uint32_t EspClass::getCycleCount()
+{
+    return (uint32_t)(micros64() * HOST_CPU_FREQ_MHZ);
+}
+
+uint8_t EspClass::getCpuFreqMHz()
+{
+    return HOST_CPU_FREQ_MHZ;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    return 40000;
+}
+
+uint32_t EspClass::random()
+{
+    return host_random();
+}
+
+//--------------------------------------------------------------------------------
+
+void host_advance(uint64_t us)
+{
+    host->time += us;
+
+    if (host_awake_time() > HOST_AWAKE_MAX)
+    {
+        fflush(stdout);
+        _exit(HOST_EXIT_HANG);
+    }
+}
+
+uint64_t host_awake_time()
+{
+    return host->time - host->wake_time;
+}
+
+uint32_t host_random()
+{
+    /* xorshift32, the state is never zero. */
+    uint32_t x = host->random;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    host->random = x;
+    return x;
+}
+
+float host_random_normal()
+{
+    /* Box-Muller transform of two uniform numbers in (0, 1]. */
+    float u = (host_random() + 1.0) / 4294967296.0;
+    float v = (host_random() + 1.0) / 4294967296.0;
+
+    return sqrtf(-2 * logf(u)) * cosf(2 * M_PI * v);
+}
@@ -0,0 +1,331 @@
+/**
+ * @file host_device.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <assert.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "host_device.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Exit status of a wake-up process which lost the connection to the simulator. */
+#define HOST_EXIT_RPC               4
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+host_state *host = nullptr;
+const host_device_config *host_config = nullptr;
+
+/** @brief Socket of the wake-up process to the simulator. */
+static int rpc_fd = -1;
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static bool write_all(int fd, const void *data, size_t size);
+static bool read_all(int fd, void *data, size_t size);
+static bool write_string(int fd, const std::string &text);
+static bool read_string(int fd, std::string *text);
+
+//--------------------------------------------------------------------------------
+
+HostDevice::HostDevice(const host_device_config &config, RtdbStandIn &database, uint64_t time)
+    : config(config), database(database)
+{
+    /* The wake-up processes write the state, it is shared instead of copied by fork(). */
+    void *memory = mmap(nullptr, sizeof(host_state), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    assert(memory != MAP_FAILED);
+
+    this->state = new (memory) host_state();
+    this->state->time = time;
+    this->state->random = config.seed ? config.seed : 1;
+    host = this->state;
+    host_config = &this->config;
+
+    power_cycle();
+}
+
+HostDevice::~HostDevice()
+{
+    this->state->~host_state();
+    munmap(this->state, sizeof(host_state));
+    host = nullptr;
+    host_config = nullptr;
+}
+
+bool HostDevice::write_file(const char *path, const std::string &content)
+{
+    uint64_t time = this->state->time;
+    bool status = false;
+
+    /* The image is written before the power-up, it takes no time of the device. */
+    this->state->wake_time = time;
+    if (LittleFS.begin())
+    {
+        File file = LittleFS.open(path, "w");
+        status = file && (file.write((const uint8_t *)content.data(), content.size()) == content.size());
+        file.close();
+    }
+
+    LittleFS.end();
+    this->state->time = time;
+    return status;
+}
+
+bool HostDevice::read_file(const char *path, std::string *content)
+{
+    uint64_t time = this->state->time;
+    bool status = false;
+
+    this->state->wake_time = time;
+    if (LittleFS.begin())
+    {
+        File file = LittleFS.open(path, "r");
+        if (file)
+        {
+            content->resize(file.size());
+            status = (file.read((uint8_t *)&(*content)[0], content->size()) == content->size());
+            file.close();
+        }
+    }
+
+    LittleFS.end();
+    this->state->time = time;
+    return status;
+}
+
+host_wake HostDevice::wake()
+{
+    host_wake result;
+    int fds[2];
+    int status;
+
+    this->state->wake_time = this->state->time;
+    this->state->sleep = 0;
+    this->state->wakes++;
+    result.reset_reason = this->state->reset_reason;
+    result.start = this->state->time;
+
+    int error = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(error == 0);
+    (void)error;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    assert(pid >= 0);
+
+    if (pid == 0)
+    {
+        close(fds[0]);
+        rpc_fd = fds[1];
+
+        setup();
+        for (;;)
+            loop();
+    }
+
+    close(fds[1]);
+    while (serve(fds[0]))
+        ;
+
+    close(fds[0]);
+    waitpid(pid, &status, 0);
+
+    result.awake = this->state->time - this->state->wake_time;
+    result.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    result.sleep = (result.status == HOST_EXIT_SLEEP) ? this->state->sleep : 0;
+
+    if (result.status == HOST_EXIT_SLEEP)
+    {
+        /* The RTC timer of the ESP8266 is not trimmed, the sleep is off by the drift. */
+        this->state->time += result.sleep + (int64_t)result.sleep * this->config.sleep_drift / 1000000;
+        this->state->reset_reason = REASON_DEEP_SLEEP_AWAKE;
+    }
+    else if (result.status == HOST_EXIT_HANG)
+    {
+        this->state->reset_reason = REASON_WDT_RST;
+    }
+    else
+    {
+        this->state->reset_reason = REASON_EXCEPTION_RST;
+    }
+
+    return result;
+}
+
+void HostDevice::power_cycle()
+{
+    /* The RTC memory keeps random content after the power-up. */
+    for (size_t i = 0; i < HOST_RTC_MEMORY_SIZE; i++)
+        this->state->rtc_memory[i] = (uint8_t)host_random();
+
+    this->state->reset_reason = REASON_DEFAULT_RST;
+    host_mpu6050_power_up();
+    host_ds18b20_power_up();
+}
+
+const host_state &HostDevice::get_state() const
+{
+    return *this->state;
+}
+
+uint64_t HostDevice::get_time() const
+{
+    return this->state->time;
+}
+
+bool HostDevice::serve(int fd)
+{
+    int32_t op;
+    uint8_t connected;
+    uint64_t time;
+    std::string arguments[3];
+    std::string results[3];
+    rtdb_answer answer;
+
+    if (!read_all(fd, &op, sizeof(op)) || !read_all(fd, &connected, sizeof(connected)) || !read_all(fd, &time, sizeof(time)))
+        return false;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (!read_string(fd, &arguments[i]))
+            return false;
+    }
+
+    switch (op)
+    {
+    case HOST_RPC_SIGN_IN:
+        answer = this->database.sign_in(time, connected, arguments[0], &results[0], &results[1], &results[2]);
+        break;
+    case HOST_RPC_REFRESH:
+        answer = this->database.refresh(time, connected, arguments[0], &results[0]);
+        break;
+    case HOST_RPC_UPDATE:
+        answer = this->database.update(time, connected, arguments[0], arguments[1], arguments[2]);
+        break;
+    default:
+        return false;
+    }
+
+    if (!write_all(fd, &answer, sizeof(answer)))
+        return false;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (!write_string(fd, results[i]))
+            return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------
+
+rtdb_answer host_rpc(host_rpc_op op, bool connected, const std::string arguments[3], std::string results[3])
+{
+    int32_t request = op;
+    uint8_t flag = connected;
+    rtdb_answer answer;
+    bool status;
+
+    status = write_all(rpc_fd, &request, sizeof(request)) && write_all(rpc_fd, &flag, sizeof(flag)) &&
+             write_all(rpc_fd, &host->time, sizeof(host->time));
+
+    for (int i = 0; status && (i < 3); i++)
+        status = write_string(rpc_fd, arguments[i]);
+
+    status = status && read_all(rpc_fd, &answer, sizeof(answer));
+
+    for (int i = 0; status && (i < 3); i++)
+        status = read_string(rpc_fd, &results[i]);
+
+    if (!status)
+        _exit(HOST_EXIT_RPC);
+
+    host->time = answer.time;
+    return answer;
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Writes all bytes to the socket.
+ * @return true on success, otherwise false
+ */
+static bool write_all(int fd, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    while (size > 0)
+    {
+        ssize_t done = write(fd, bytes, size);
+
+        if (done <= 0)
+            return false;
+
+        bytes += done;
+        size -= done;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads the bytes from the socket.
+ * @return true if all bytes were read, false at the end of the stream or on error
+ */
+static bool read_all(int fd, void *data, size_t size)
+{
+    uint8_t *bytes = (uint8_t *)data;
+
+    while (size > 0)
+    {
+        ssize_t done = read(fd, bytes, size);
+
+        if (done <= 0)
+            return false;
+
+        bytes += done;
+        size -= done;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes the string with its length.
+ * @return true on success, otherwise false
+ */
+static bool write_string(int fd, const std::string &text)
+{
+    uint32_t size = text.size();
+
+    return write_all(fd, &size, sizeof(size)) && write_all(fd, text.data(), size);
+}
+
+/**
+ * @brief Reads a string written by write_string().
+ * @return true on success, otherwise false
+ */
+static bool read_string(int fd, std::string *text)
+{
+    uint32_t size;
+
+    if (!read_all(fd, &size, sizeof(size)))
+        return false;
+
+    text->resize(size);
+    return (size == 0) || read_all(fd, &(*text)[0], size);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file host_device.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_DEVICE_H_
+#define HOST_DEVICE_H_
+
+//--------------------------------------------------------------------------------
+
+#include <string>
+#include "host_hal.h"
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Result of a wake-up. */
+struct host_wake
+{
+    int status;             /**< HOST_EXIT_SLEEP, HOST_EXIT_HANG, or -1 if the firmware crashed. */
+    uint32_t reset_reason;  /**< Reason of the reset which started the wake-up, rst_reason of the SDK. */
+    uint64_t start;         /**< Time of the reset, in us since epoch. */
+    uint64_t awake;         /**< Time from the reset to the deep sleep or the end of the wake-up, in us. */
+    uint64_t sleep;         /**< Deep sleep requested by the firmware, in us, 0 if it did not go to sleep. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Hydrometer simulated on the host, the firmware of src/ runs one wake-up at a time.
+ *
+ *        Every wake-up is a child process which runs setup() and loop() from a fresh copy of the
+ *        firmware, like a reset clears the RAM of the ESP8266, until ESP.deepSleep() ends it.
+ *        What survives the reset, the RTC memory, the flash and the sensors which stay powered,
+ *        is in host_state shared with the child. The time is virtual: the simulators advance it by
+ *        the time every bus transfer, conversion, connection and flash access takes, so a wake-up
+ *        takes no real time and a run is reproducible for the seed of the configuration.
+ *
+ *        The database stays in this process, the Firebase client of the child sends its requests
+ *        to the RtdbStandIn over a socket and gets the time of the answers back.
+ *        Only one device exists at a time, it sets the globals host and host_config.
+ */
+class HostDevice
+{
+public:
+
+    /**
+     * @brief Construct a new device with an empty flash, powered up at the time.
+     * @param [in] config - device and its environment
+     * @param [in] database - stand-in of the database the device uploads to
+     * @param [in] time - time of the power-up, in us since epoch
+     */
+    HostDevice(const host_device_config &config, RtdbStandIn &database, uint64_t time);
+    ~HostDevice();
+
+    HostDevice(const HostDevice &) = delete;
+    HostDevice &operator=(const HostDevice &) = delete;
+
+    /**
+     * @brief Writes the file to the flash without the firmware, like uploading the file system image.
+     * @param [in] path - path of the file
+     * @param [in] content - content of the file
+     * @return true on success, otherwise false
+     */
+    bool write_file(const char *path, const std::string &content);
+
+    /**
+     * @brief Reads the file from the flash without the firmware.
+     * @param [in] path - path of the file
+     * @param [out] content - content of the file
+     * @return true if the file exists, otherwise false
+     */
+    bool read_file(const char *path, std::string *content);
+
+    /**
+     * @brief Runs the firmware from the reset to the deep sleep, then sleeps until the next reset.
+     * @return host_wake - result of the wake-up
+     */
+    host_wake wake();
+
+    /**
+     * @brief Removes and inserts the battery, the RTC memory is lost and the sensors are reset.
+     */
+    void power_cycle();
+
+    /**
+     * @brief Get the state of the device, the counters of the simulators included.
+     * @return const host_state& - state
+     */
+    const host_state &get_state() const;
+
+    /**
+     * @brief Get the time of the device.
+     * @return uint64_t - time in us since epoch
+     */
+    uint64_t get_time() const;
+
+private:
+
+    /**
+     * @brief Answers one request of the wake-up process.
+     * @param [in] fd - socket of the wake-up process
+     * @return false when the wake-up process has ended, otherwise true
+     */
+    bool serve(int fd);
+
+    host_device_config config;  /**< Device and its environment. */
+    RtdbStandIn &database;      /**< Stand-in of the database. */
+    host_state *state;          /**< State shared with the wake-up processes. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_DEVICE_H_ */
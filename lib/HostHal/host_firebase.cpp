@@ -0,0 +1,311 @@
+/**
+ * @file host_firebase.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <Firebase_ESP_Client.h>
+#include <ESP8266WiFi.h>
+#include "host_hal.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Error of a request without a connection to the network, from the Firebase library. */
+#define HOST_FIREBASE_ERROR_CONNECTION_REFUSED  (-1)
+
+/** @brief Error of a request without a usable ID token, from the Firebase library. */
+#define HOST_FIREBASE_ERROR_TOKEN_NOT_READY     (-252)
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+FirebaseClass Firebase;
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static std::string quote(const String &text);
+static std::string format(const char *format, double value);
+static String status_reason(int code);
+
+//--------------------------------------------------------------------------------
+
+FirebaseJson &FirebaseJson::add(const String &key, float value)
+{
+    return append(key, format("%.7g", value));
+}
+
+FirebaseJson &FirebaseJson::add(const String &key, double value)
+{
+    return append(key, format("%.9g", value));
+}
+
+FirebaseJson &FirebaseJson::add(const String &key, int value)
+{
+    return append(key, std::to_string(value));
+}
+
+FirebaseJson &FirebaseJson::add(const String &key, bool value)
+{
+    return append(key, value ? "true" : "false");
+}
+
+FirebaseJson &FirebaseJson::add(const String &key, const String &value)
+{
+    return append(key, quote(value));
+}
+
+bool FirebaseJson::toString(String &buffer, bool prettify) const
+{
+    (void)prettify;
+    buffer = String("{" + body + "}");
+    return true;
+}
+
+FirebaseJson &FirebaseJson::append(const String &key, const std::string &value)
+{
+    if (!body.empty())
+        body += ',';
+
+    body += quote(key) + ':' + value;
+    return *this;
+}
+
+FirebaseJsonArray &FirebaseJsonArray::add(const String &value)
+{
+    values.push_back(value);
+    return *this;
+}
+
+//--------------------------------------------------------------------------------
+
+bool FB_RTDB::updateNodeSilent(FirebaseData *fbdo, const String &path, FirebaseJson *json)
+{
+    String body;
+
+    json->toString(body);
+    return update(fbdo, path, body.c_str());
+}
+
+bool FB_RTDB::setArray(FirebaseData *fbdo, const String &path, FirebaseJsonArray *array)
+{
+    FirebaseJson json;
+    String body;
+
+    for (size_t i = 0; i < array->size(); i++)
+        json.add(String((unsigned int)i), array->get(i));
+
+    json.toString(body);
+    return update(fbdo, path, body.c_str());
+}
+
+bool FB_RTDB::update(FirebaseData *fbdo, const String &path, const std::string &body)
+{
+    std::string arguments[3];
+    std::string results[3];
+
+    if (!WiFi.isConnected())
+    {
+        fbdo->connected = false;
+        fbdo->code = HOST_FIREBASE_ERROR_CONNECTION_REFUSED;
+        fbdo->reason = status_reason(fbdo->code);
+        return false;
+    }
+
+    if (!Firebase.ready())
+    {
+        fbdo->code = HOST_FIREBASE_ERROR_TOKEN_NOT_READY;
+        fbdo->reason = status_reason(fbdo->code);
+        return false;
+    }
+
+    arguments[0] = Firebase.getToken();
+    arguments[1] = path.c_str();
+    arguments[2] = body;
+
+    rtdb_answer answer = host_rpc(HOST_RPC_UPDATE, fbdo->connected, arguments, results);
+
+    /* The client closes a connection without an answer, the next request opens a new one. */
+    fbdo->connected = (answer.status != RTDB_STATUS_TIMEOUT);
+    fbdo->code = answer.status;
+    fbdo->reason = status_reason(answer.status);
+
+    /* A rejected token is refreshed by the next ready(). */
+    if (answer.status == RTDB_STATUS_UNAUTHORIZED)
+    {
+        std::string refresh_token = Firebase.getRefreshToken();
+        Firebase.setIdToken(nullptr, Firebase.getToken(), 0, refresh_token.c_str());
+    }
+
+    return answer.status == RTDB_STATUS_NO_CONTENT;
+}
+
+//--------------------------------------------------------------------------------
+
+void FirebaseClass::begin(FirebaseConfig *config, FirebaseAuth *auth)
+{
+    (void)config;
+    this->auth = auth;
+
+    if (token.empty() && (auth->user.email.length() > 0))
+        authenticate();
+}
+
+bool FirebaseClass::ready()
+{
+    if (!token.empty() && !isTokenExpired())
+    {
+        info.status = token_status_ready;
+        return true;
+    }
+
+    return authenticate();
+}
+
+bool FirebaseClass::isTokenExpired()
+{
+    return host->time >= expires;
+}
+
+void FirebaseClass::setIdToken(FirebaseConfig *config, const char *id_token, size_t expire, const char *refresh_token)
+{
+    (void)config;
+    token = id_token;
+    this->refresh_token = refresh_token;
+    expires = host->time + (uint64_t)expire * 1000000;
+    info.status = (expire > 0) ? token_status_ready : token_status_on_refresh;
+}
+
+void FirebaseClass::refreshToken(FirebaseConfig *config)
+{
+    (void)config;
+    expires = 0;
+    authenticate();
+}
+
+bool FirebaseClass::authenticate()
+{
+    std::string arguments[3];
+    std::string results[3];
+    bool has_email = (auth != nullptr) && (auth->user.email.length() > 0);
+    rtdb_answer answer = {};
+
+    if (refresh_token.empty() && !has_email)
+        return false;
+
+    if (!WiFi.isConnected())
+    {
+        info.status = token_status_error;
+        info.error.code = HOST_FIREBASE_ERROR_CONNECTION_REFUSED;
+        info.error.message = status_reason(info.error.code).c_str();
+        return false;
+    }
+
+    if (!refresh_token.empty())
+    {
+        info.status = token_status_on_refresh;
+        arguments[0] = refresh_token;
+        answer = host_rpc(HOST_RPC_REFRESH, false, arguments, results);
+
+        if (answer.status == RTDB_STATUS_OK)
+        {
+            token = results[0];
+            expires = host->time + (uint64_t)HOST_FIREBASE_TOKEN_LIFETIME * 1000000;
+            info.status = token_status_ready;
+            return true;
+        }
+    }
+
+    /* A refresh token the server does not know needs the password again. */
+    if (has_email && (refresh_token.empty() || ((answer.status >= 400) && (answer.status < 500))))
+    {
+        info.status = token_status_on_signing;
+        arguments[0] = auth->user.email.c_str();
+        answer = host_rpc(HOST_RPC_SIGN_IN, false, arguments, results);
+
+        if (answer.status == RTDB_STATUS_OK)
+        {
+            token = results[0];
+            refresh_token = results[1];
+            auth->token.uid = results[2];
+            expires = host->time + (uint64_t)HOST_FIREBASE_TOKEN_LIFETIME * 1000000;
+            info.status = token_status_ready;
+            return true;
+        }
+    }
+
+    info.status = token_status_error;
+    info.error.code = answer.status;
+    info.error.message = status_reason(answer.status).c_str();
+    return false;
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Quotes and escapes the string.
+ * @param [in] text - string
+ * @return std::string - JSON string
+ */
+static std::string quote(const String &text)
+{
+    std::string quoted = "\"";
+
+    for (const char *c = text.c_str(); *c; c++)
+    {
+        if ((*c == '"') || (*c == '\\'))
+            quoted += '\\';
+
+        quoted += *c;
+    }
+
+    return quoted + '"';
+}
+
+/**
+ * @brief Formats the number.
+ * @param [in] format - printf() format of a double
+ * @param [in] value - number
+ * @return std::string - formatted number
+ */
+static std::string format(const char *format, double value)
+{
+    char buf[32];
+
+    snprintf(buf, sizeof(buf), format, value);
+    return buf;
+}
+
+/**
+ * @brief Get the error message of the status, like errorReason() of the Firebase library.
+ * @param [in] code - HTTP status or error of the library
+ * @return String - message, empty for a success
+ */
+static String status_reason(int code)
+{
+    switch (code)
+    {
+    case RTDB_STATUS_OK:
+    case RTDB_STATUS_NO_CONTENT:
+        return String();
+    case HOST_FIREBASE_ERROR_CONNECTION_REFUSED:
+        return String("connection refused");
+    case HOST_FIREBASE_ERROR_TOKEN_NOT_READY:
+        return String("token is not ready (revoked or expired)");
+    case RTDB_STATUS_TIMEOUT:
+        return String("response read timed out");
+    case RTDB_STATUS_BAD_REQUEST:
+        return String("bad request");
+    case RTDB_STATUS_UNAUTHORIZED:
+        return String("unauthorized");
+    case RTDB_STATUS_TOO_MANY:
+        return String("too many requests");
+    case RTDB_STATUS_UNAVAILABLE:
+        return String("service unavailable");
+    default:
+        return String("error ") + code;
+    }
+}
@@ -0,0 +1,305 @@
+/**
+ * @file host_fs.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <FS.h>
+#include <LittleFS.h>
+#include "host_hal.h"
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+fs::FS LittleFS(true);
+fs::FS SPIFFS(false);
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static int find(const char *path);
+static bool resize(int id, uint32_t size);
+static void transfer_time(size_t size, uint32_t rate);
+
+//--------------------------------------------------------------------------------
+
+size_t fs::File::size() const
+{
+    if (!fs)
+        return 0;
+
+    return host->flash.files[id].size;
+}
+
+bool fs::File::seek(uint32_t pos, SeekMode mode)
+{
+    size_t base = 0;
+
+    if (!fs)
+        return false;
+
+    if (mode == SeekCur)
+        base = offset;
+    else if (mode == SeekEnd)
+        base = size();
+
+    if (base + pos > size())
+        return false;
+
+    offset = base + pos;
+    return true;
+}
+
+bool fs::File::truncate(uint32_t size)
+{
+    if (!fs || !writable)
+        return false;
+
+    if (!resize(id, size))
+        return false;
+
+    offset = std::min<size_t>(offset, size);
+    return true;
+}
+
+size_t fs::File::read(uint8_t *buffer, size_t size)
+{
+    host_flash &flash = host->flash;
+    size_t done = 0;
+
+    if (!fs || (offset >= this->size()))
+        return 0;
+
+    size = std::min(size, this->size() - offset);
+    while (done < size)
+    {
+        uint32_t block = flash.files[id].blocks[offset / HOST_FLASH_BLOCK_SIZE];
+        size_t start = offset % HOST_FLASH_BLOCK_SIZE;
+        size_t chunk = std::min(size - done, (size_t)HOST_FLASH_BLOCK_SIZE - start);
+
+        memcpy(&buffer[done], &flash.data[block][start], chunk);
+        done += chunk;
+        offset += chunk;
+    }
+
+    flash.read += done;
+    transfer_time(done, HOST_FLASH_READ_RATE);
+    return done;
+}
+
+size_t fs::File::write(const uint8_t *buffer, size_t size)
+{
+    host_flash &flash = host->flash;
+    size_t done = 0;
+
+    if (!fs || !writable)
+        return 0;
+
+    /* A file which does not fit the partition is not extended at all. */
+    if ((offset + size > this->size()) && !resize(id, offset + size))
+        return 0;
+
+    while (done < size)
+    {
+        uint32_t block = flash.files[id].blocks[offset / HOST_FLASH_BLOCK_SIZE];
+        size_t start = offset % HOST_FLASH_BLOCK_SIZE;
+        size_t chunk = std::min(size - done, (size_t)HOST_FLASH_BLOCK_SIZE - start);
+
+        memcpy(&flash.data[block][start], &buffer[done], chunk);
+        done += chunk;
+        offset += chunk;
+    }
+
+    flash.written += done;
+    transfer_time(done, HOST_FLASH_WRITE_RATE);
+    return done;
+}
+
+void fs::File::close()
+{
+    fs = nullptr;
+    id = -1;
+}
+
+//--------------------------------------------------------------------------------
+
+bool fs::FS::begin()
+{
+    if (!partition)
+        return false;
+
+    if (!mounted)
+        host_advance(HOST_FLASH_OPEN_TIME);
+
+    mounted = true;
+    return true;
+}
+
+void fs::FS::end()
+{
+    mounted = false;
+}
+
+bool fs::FS::format()
+{
+    host_flash &flash = host->flash;
+
+    if (!partition)
+        return false;
+
+    memset(flash.used, 0, sizeof(flash.used));
+    memset(flash.files, 0, sizeof(flash.files));
+    host_advance(HOST_FLASH_OPEN_TIME);
+    return true;
+}
+
+fs::File fs::FS::open(const char *path, const char *mode)
+{
+    host_flash &flash = host->flash;
+    bool writable = (strchr(mode, '+') != nullptr) || (mode[0] == 'w') || (mode[0] == 'a');
+    int id;
+
+    if (!mounted || (strlen(path) >= HOST_FLASH_NAME_SIZE))
+        return File();
+
+    host_advance(HOST_FLASH_OPEN_TIME);
+    id = find(path);
+
+    if ((id < 0) && (mode[0] != 'r'))
+    {
+        for (id = 0; id < HOST_FLASH_FILES; id++)
+        {
+            if (flash.files[id].name[0] == '\0')
+                break;
+        }
+
+        if (id == HOST_FLASH_FILES)
+            return File();
+
+        strcpy(flash.files[id].name, path);
+        flash.files[id].size = 0;
+    }
+
+    if (id < 0)
+        return File();
+
+    if (mode[0] == 'w')
+        resize(id, 0);
+
+    File file(this, id, writable);
+    if (mode[0] == 'a')
+        file.seek(0, SeekEnd);
+
+    return file;
+}
+
+bool fs::FS::exists(const char *path)
+{
+    return mounted && (find(path) >= 0);
+}
+
+bool fs::FS::remove(const char *path)
+{
+    int id = mounted ? find(path) : -1;
+
+    if (id < 0)
+        return false;
+
+    resize(id, 0);
+    host->flash.files[id].name[0] = '\0';
+    host_advance(HOST_FLASH_OPEN_TIME);
+    return true;
+}
+
+bool fs::FS::rename(const char *from, const char *to)
+{
+    int id = mounted ? find(from) : -1;
+
+    if ((id < 0) || (strlen(to) >= HOST_FLASH_NAME_SIZE))
+        return false;
+
+    /* Like LittleFS, an existing destination is replaced. */
+    if (find(to) >= 0)
+        remove(to);
+
+    strcpy(host->flash.files[id].name, to);
+    host_advance(HOST_FLASH_OPEN_TIME);
+    return true;
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Finds the file.
+ * @param [in] path - path of the file
+ * @return int - index of the file in host_flash, -1 if it does not exist
+ */
+static int find(const char *path)
+{
+    for (int id = 0; id < HOST_FLASH_FILES; id++)
+    {
+        if (strcmp(host->flash.files[id].name, path) == 0)
+            return id;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Allocates or frees the blocks of the file for the new size.
+ * @param [in] id - index of the file
+ * @param [in] size - new size, in bytes
+ * @return true if the partition has enough free blocks, otherwise false and the file is unchanged
+ */
+static bool resize(int id, uint32_t size)
+{
+    host_flash &flash = host->flash;
+    host_flash_file &file = flash.files[id];
+    uint32_t have = (file.size + HOST_FLASH_BLOCK_SIZE - 1) / HOST_FLASH_BLOCK_SIZE;
+    uint32_t need = (size + HOST_FLASH_BLOCK_SIZE - 1) / HOST_FLASH_BLOCK_SIZE;
+    uint32_t block = 0;
+
+    if (need > HOST_FLASH_BLOCKS)
+        return false;
+
+    for (uint32_t i = have; i < need; i++)
+    {
+        while ((block < HOST_FLASH_BLOCKS) && flash.used[block])
+            block++;
+
+        if (block == HOST_FLASH_BLOCKS)
+        {
+            /* Not enough space, give back the blocks taken so far. */
+            for (uint32_t j = have; j < i; j++)
+                flash.used[file.blocks[j]] = 0;
+
+            return false;
+        }
+
+        flash.used[block] = 1;
+        file.blocks[i] = block;
+    }
+
+    for (uint32_t i = need; i < have; i++)
+        flash.used[file.blocks[i]] = 0;
+
+    /* A grown file reads zeros past its old end. */
+    for (uint32_t pos = file.size; pos < size; pos++)
+        flash.data[file.blocks[pos / HOST_FLASH_BLOCK_SIZE]][pos % HOST_FLASH_BLOCK_SIZE] = 0;
+
+    file.size = size;
+    return true;
+}
+
+/**
+ * @brief Advances the time by the transfer of the data to or from the flash.
+ * @param [in] size - transferred bytes
+ * @param [in] rate - throughput, in bytes per ms
+ */
+static void transfer_time(size_t size, uint32_t rate)
+{
+    host_advance((uint64_t)size * 1000 / rate);
+}
@@ -0,0 +1,205 @@
+/**
+ * @file host_hal.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_HAL_H_
+#define HOST_HAL_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <rtdb_stand_in.h>
+
+//--------------------------------------------------------------------------------
+
+/** @brief Size of the RTC user memory of the ESP8266, in bytes. */
+#define HOST_RTC_MEMORY_SIZE        512
+
+/** @brief Size of an erase block of the flash, in bytes. */
+#define HOST_FLASH_BLOCK_SIZE       4096
+
+/** @brief Number of blocks of the LittleFS partition, 1 MB like the 4M1M layout of the d1_mini. */
+#define HOST_FLASH_BLOCKS           256
+
+/** @brief Maximum number of files in the LittleFS partition. */
+#define HOST_FLASH_FILES            16
+
+/** @brief Maximum length of a file path, with the terminating zero. */
+#define HOST_FLASH_NAME_SIZE        32
+
+/** @brief Number of registers of the MPU6050. */
+#define HOST_MPU6050_REGISTERS      128
+
+/** @brief Size of the FIFO of the MPU6050, in bytes. */
+#define HOST_MPU6050_FIFO_SIZE      1024
+
+/** @brief Size of the scratchpad of the DS18B20, with the CRC. */
+#define HOST_DS18B20_SCRATCHPAD     9
+
+/** @brief Exit status of a wake-up which ended in deep sleep. */
+#define HOST_EXIT_SLEEP             0
+
+/** @brief Exit status of a wake-up which was awake longer than HOST_AWAKE_MAX, like a hung firmware. */
+#define HOST_EXIT_HANG              3
+
+/** @brief Longest wake-up, in us, a longer one is ended as hung. */
+#define HOST_AWAKE_MAX              600000000ULL
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/**
+ * @brief Environment of the simulated device, every function gets the time since epoch in us.
+ *        The functions are called in the process of the wake-up, they must not keep state.
+ */
+struct host_environment
+{
+    float (*tilt)(uint64_t time);           /**< Tilt of the floating hydrometer from the vertical axis, in degrees. */
+    float (*swing)(uint64_t time);          /**< Amplitude of the swinging of a disturbed hydrometer, in degrees. */
+    float (*temperature)(uint64_t time);    /**< Temperature of the wort, in °C. */
+    float (*battery)(uint64_t time);        /**< Voltage of the battery, in V. */
+    bool (*network)(uint64_t time);         /**< Whether the access point and the internet are reachable. */
+};
+
+/** @brief Simulated device and its surroundings. */
+struct host_device_config
+{
+    host_environment environment;   /**< Environment of the device. */
+    uint32_t chip_id;               /**< Chip ID of the ESP8266, also seeds the ROM code of the DS18B20. */
+    uint32_t seed;                  /**< Seed of the sensor noise and of ESP.random(). */
+    float tilt_noise;               /**< Standard deviation of the tilt of a single accelerometer sample, in degrees. */
+    int32_t sleep_drift;            /**< Error of the deep sleep timer, in ppm, positive when it sleeps longer. */
+    const char *ssid;               /**< SSID of the access point. */
+    const char *password;           /**< Password of the access point. */
+    uint32_t connect_time;          /**< Time of a connection with a scan and DHCP, in ms. */
+    uint32_t fast_connect_time;     /**< Time of a connection to a known channel and BSSID with a static address, in ms. */
+    uint32_t lease;                 /**< DHCP lease time, in seconds. */
+};
+
+/** @brief File of the RAM backed LittleFS. */
+struct host_flash_file
+{
+    char name[HOST_FLASH_NAME_SIZE];        /**< Path of the file, empty if the entry is free. */
+    uint32_t size;                          /**< Size of the file, in bytes. */
+    uint16_t blocks[HOST_FLASH_BLOCKS];     /**< Blocks of the file in order. */
+};
+
+/** @brief RAM backed LittleFS partition, it survives deep sleep and power loss. */
+struct host_flash
+{
+    uint8_t data[HOST_FLASH_BLOCKS][HOST_FLASH_BLOCK_SIZE];     /**< Content of the blocks. */
+    uint8_t used[HOST_FLASH_BLOCKS];                            /**< Whether the block belongs to a file. */
+    host_flash_file files[HOST_FLASH_FILES];                    /**< Files. */
+    uint64_t written;                                           /**< Bytes written since the first wake-up. */
+    uint64_t read;                                              /**< Bytes read since the first wake-up. */
+};
+
+/** @brief Registers and FIFO of the MPU6050, it stays powered in deep sleep. */
+struct host_mpu6050
+{
+    uint8_t registers[HOST_MPU6050_REGISTERS];  /**< Register file. */
+    uint8_t fifo[HOST_MPU6050_FIFO_SIZE];       /**< FIFO, a ring buffer. */
+    uint16_t fifo_head;                         /**< Index of the oldest byte of the FIFO. */
+    uint16_t fifo_count;                        /**< Number of bytes in the FIFO. */
+    uint8_t pointer;                            /**< Register address of the next access. */
+    uint64_t sample_time;                       /**< Time of the next sample, in us since epoch. */
+    uint64_t update_time;                       /**< Time the sensor was last brought up to date, in us since epoch. */
+    uint32_t samples;                           /**< Samples taken since the power-up. */
+    uint32_t transactions;                      /**< I2C transactions addressed to the sensor. */
+};
+
+/** @brief Scratchpad, EEPROM and conversion of the DS18B20, it stays powered in deep sleep. */
+struct host_ds18b20
+{
+    uint8_t rom[8];                                 /**< ROM code, family 0x28 and CRC. */
+    uint8_t scratchpad[HOST_DS18B20_SCRATCHPAD];    /**< Scratchpad with its CRC. */
+    uint8_t eeprom[3];                              /**< TH, TL and the configuration saved in EEPROM. */
+    uint64_t conversion_end;                        /**< Time the running conversion ends, in us since epoch, 0 if none. */
+    uint32_t conversions;                           /**< Started conversions. */
+    uint32_t eeprom_writes;                         /**< Copies of the scratchpad to EEPROM. */
+};
+
+/** @brief State of the device kept across the wake-ups, shared by the wake-up processes and the simulator. */
+struct host_state
+{
+    uint64_t time;                              /**< Time since epoch, in us. */
+    uint64_t wake_time;                         /**< Time of the start of the current wake-up, in us since epoch. */
+    uint64_t sleep;                             /**< Deep sleep requested by the last wake-up, in us. */
+    uint32_t reset_reason;                      /**< Reason of the reset, rst_reason of the SDK. */
+    uint32_t random;                            /**< State of the pseudo-random generator of the sensors. */
+    uint32_t wakes;                             /**< Number of started wake-ups. */
+    uint8_t rf_mode;                            /**< Radio mode after the requested deep sleep. */
+    uint8_t rtc_memory[HOST_RTC_MEMORY_SIZE];   /**< RTC user memory. */
+    host_flash flash;                           /**< LittleFS partition. */
+    host_mpu6050 mpu6050;                       /**< Accelerometer. */
+    host_ds18b20 ds18b20;                       /**< Temperature sensor. */
+};
+
+/** @brief Requests of the wake-up process to the stand-in of the database in the simulator. */
+enum host_rpc_op
+{
+    HOST_RPC_SIGN_IN,   /**< RtdbStandIn::sign_in(), arguments: email; results: token, refresh token, uid. */
+    HOST_RPC_REFRESH,   /**< RtdbStandIn::refresh(), arguments: refresh token; results: token. */
+    HOST_RPC_UPDATE     /**< RtdbStandIn::update(), arguments: token, path, body. */
+};
+
+//--------------------------------------------------------------------------------
+
+/** @brief State of the simulated device, set by HostDevice. */
+extern host_state *host;
+
+/** @brief Configuration of the simulated device, set by HostDevice. */
+extern const host_device_config *host_config;
+
+/**
+ * @brief Advances the time of the device, the firmware does nothing else in the meantime.
+ *        A wake-up longer than HOST_AWAKE_MAX exits with HOST_EXIT_HANG.
+ * @param [in] us - time in us
+ */
+void host_advance(uint64_t us);
+
+/**
+ * @brief Get the time since the start of the wake-up.
+ * @return uint64_t - time in us
+ */
+uint64_t host_awake_time();
+
+/**
+ * @brief Pseudo-random number of the sensor simulators, deterministic for the seed of the device.
+ * @return uint32_t - random number
+ */
+uint32_t host_random();
+
+/**
+ * @brief Normally distributed pseudo-random number.
+ * @return float - random number with zero mean and unit standard deviation
+ */
+float host_random_normal();
+
+/**
+ * @brief Sends a request of the wake-up process to the stand-in of the database and waits for its answer.
+ *        The time of the device is advanced to the time of the answer.
+ * @param [in] op - request
+ * @param [in] connected - false if the request opens a new connection
+ * @param [in] arguments - string arguments of the request, @see host_rpc_op
+ * @param [out] results - string results of the request, @see host_rpc_op
+ * @return rtdb_answer - answer of the stand-in
+ */
+rtdb_answer host_rpc(host_rpc_op op, bool connected, const std::string arguments[3], std::string results[3]);
+
+/** @brief Resets the MPU6050 to its power-up state. */
+void host_mpu6050_power_up();
+
+/** @brief Resets the DS18B20 to its power-up state, the scratchpad is loaded from EEPROM. */
+void host_ds18b20_power_up();
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_HAL_H_ */
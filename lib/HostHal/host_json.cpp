@@ -0,0 +1,272 @@
+/**
+ * @file host_json.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <ArduinoJson.h>
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static void skip_space(const char *&p);
+static bool parse_string(const char *&p, std::string &text);
+static bool parse_literal(const char *&p, std::string &text);
+static std::string quote(const std::string &text);
+
+//--------------------------------------------------------------------------------
+
+JsonVariant &JsonVariant::operator=(const char *value)
+{
+    if (value == nullptr)
+    {
+        type = TYPE_LITERAL;
+        text = "null";
+        return *this;
+    }
+
+    type = TYPE_STRING;
+    text = value;
+    return *this;
+}
+
+JsonVariant &JsonVariant::operator=(bool value)
+{
+    type = TYPE_LITERAL;
+    text = value ? "true" : "false";
+    return *this;
+}
+
+void JsonVariant::set_number(const std::string &value)
+{
+    type = TYPE_LITERAL;
+    text = value;
+}
+
+JsonVariant &JsonObject::operator[](const char *key)
+{
+    for (auto &member : members)
+    {
+        if (member.first == key)
+            return member.second;
+    }
+
+    members.emplace_back(key, JsonVariant());
+    return members.back().second;
+}
+
+bool JsonObject::parse(const char *json)
+{
+    const char *p = json;
+
+    clear();
+    if (p == nullptr)
+        return false;
+
+    skip_space(p);
+    if (*p++ != '{')
+        return false;
+
+    skip_space(p);
+    if (*p == '}')
+    {
+        valid = true;
+        return true;
+    }
+
+    for (;;)
+    {
+        std::string key;
+        JsonVariant value;
+
+        skip_space(p);
+        if (!parse_string(p, key))
+            break;
+
+        skip_space(p);
+        if (*p++ != ':')
+            break;
+
+        skip_space(p);
+        if (*p == '"')
+        {
+            value.type = JsonVariant::TYPE_STRING;
+            if (!parse_string(p, value.text))
+                break;
+        }
+        else
+        {
+            value.type = JsonVariant::TYPE_LITERAL;
+            if (!parse_literal(p, value.text))
+                break;
+        }
+
+        members.emplace_back(key, value);
+        skip_space(p);
+
+        if (*p == ',')
+        {
+            p++;
+            continue;
+        }
+
+        if (*p == '}')
+        {
+            valid = true;
+            return true;
+        }
+
+        break;
+    }
+
+    members.clear();
+    return false;
+}
+
+void JsonObject::clear()
+{
+    members.clear();
+    valid = false;
+}
+
+std::string JsonObject::serialize() const
+{
+    std::string text = "{";
+
+    for (const auto &member : members)
+    {
+        if (!member.second.success())
+            continue;
+
+        if (text.size() > 1)
+            text += ',';
+
+        text += quote(member.first) + ':';
+        text += (member.second.type == JsonVariant::TYPE_STRING) ? quote(member.second.text) : member.second.text;
+    }
+
+    return text + "}";
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Skips white space.
+ * @param [in, out] p - position in the text
+ */
+static void skip_space(const char *&p)
+{
+    while ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n'))
+        p++;
+}
+
+/**
+ * @brief Parses a JSON string, \\u escapes are kept only for ASCII.
+ * @param [in, out] p - position of the opening quote, on success the position after the closing one
+ * @param [out] text - unescaped string
+ * @return true if the string is valid, otherwise false
+ */
+static bool parse_string(const char *&p, std::string &text)
+{
+    if (*p++ != '"')
+        return false;
+
+    text.clear();
+    while (*p != '"')
+    {
+        char c = *p++;
+
+        if (c == '\0')
+            return false;
+
+        if (c == '\\')
+        {
+            c = *p++;
+            switch (c)
+            {
+            case 'n': c = '\n'; break;
+            case 't': c = '\t'; break;
+            case 'r': c = '\r'; break;
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'u':
+                if (strlen(p) < 4)
+                    return false;
+
+                c = (char)strtol(std::string(p, 4).c_str(), nullptr, 16);
+                p += 4;
+                break;
+            case '"':
+            case '\\':
+            case '/':
+                break;
+            default:
+                return false;
+            }
+        }
+
+        text += c;
+    }
+
+    p++;
+    return true;
+}
+
+/**
+ * @brief Parses a number, true, false or null.
+ * @param [in, out] p - position of the value, on success the position after it
+ * @param [out] text - text of the value
+ * @return true if the value is valid, otherwise false
+ */
+static bool parse_literal(const char *&p, std::string &text)
+{
+    const char *start = p;
+    char *end;
+
+    for (const char *literal : {"true", "false", "null"})
+    {
+        if (strncmp(p, literal, strlen(literal)) == 0)
+        {
+            p += strlen(literal);
+            text = literal;
+            return true;
+        }
+    }
+
+    strtod(start, &end);
+    if (end == start)
+        return false;
+
+    p = end;
+    text.assign(start, end - start);
+    return true;
+}
+
+/**
+ * @brief Quotes and escapes the string.
+ * @param [in] text - string
+ * @return std::string - JSON string
+ */
+static std::string quote(const std::string &text)
+{
+    std::string quoted = "\"";
+
+    for (char c : text)
+    {
+        if ((c == '"') || (c == '\\'))
+            quoted += '\\';
+
+        if (c == '\n')
+        {
+            quoted += "\\n";
+            continue;
+        }
+
+        quoted += c;
+    }
+
+    return quoted + '"';
+}
@@ -0,0 +1,333 @@
+/**
+ * @file host_one_wire.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <OneWire.h>
+#include "host_hal.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Reset pulse and presence detection, in us. */
+#define HOST_ONE_WIRE_RESET_TIME    960
+
+/** @brief Read or write time slot with its recovery, in us. */
+#define HOST_ONE_WIRE_SLOT_TIME     70
+
+/** @brief Conversion time at 12 bits, the datasheet maximum is 750 ms, in us. */
+#define HOST_DS18B20_CONVERSION     600000
+
+/** @brief Copy of the scratchpad to EEPROM, in us. */
+#define HOST_DS18B20_COPY_TIME      10000
+
+/* ROM commands. */
+#define CMD_MATCH_ROM               0x55
+#define CMD_SKIP_ROM                0xCC
+
+/* Function commands of the DS18B20. */
+#define CMD_CONVERT_T               0x44
+#define CMD_WRITE_SCRATCHPAD        0x4E
+#define CMD_READ_SCRATCHPAD         0xBE
+#define CMD_COPY_SCRATCHPAD         0x48
+#define CMD_RECALL_EEPROM           0xB8
+#define CMD_READ_POWER_SUPPLY       0xB4
+
+/* Bytes of the scratchpad. */
+#define SCRATCHPAD_TEMP_LSB         0
+#define SCRATCHPAD_TEMP_MSB         1
+#define SCRATCHPAD_TH               2
+#define SCRATCHPAD_CONFIG           4
+#define SCRATCHPAD_CRC              8
+
+/** @brief Family code of the DS18B20. */
+#define DS18B20_FAMILY              0x28
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static void ds18b20_update();
+static uint8_t ds18b20_resolution();
+static void ds18b20_seal();
+static void slots(uint32_t count);
+
+//--------------------------------------------------------------------------------
+
+void OneWire::begin(uint8_t pin)
+{
+    (void)pin;
+    state = STAGE_IDLE;
+    searched = false;
+}
+
+uint8_t OneWire::reset()
+{
+    host_advance(HOST_ONE_WIRE_RESET_TIME);
+    ds18b20_update();
+    state = STAGE_ROM_COMMAND;
+    return 1;
+}
+
+void OneWire::select(const uint8_t rom[8])
+{
+    slots(9 * 8);
+    if (state != STAGE_ROM_COMMAND)
+        return;
+
+    state = (memcmp(rom, host->ds18b20.rom, sizeof(host->ds18b20.rom)) == 0) ? STAGE_FUNCTION : STAGE_DESELECTED;
+}
+
+void OneWire::skip()
+{
+    slots(8);
+    if (state == STAGE_ROM_COMMAND)
+        state = STAGE_FUNCTION;
+}
+
+void OneWire::write(uint8_t value, uint8_t power)
+{
+    host_ds18b20 &sensor = host->ds18b20;
+
+    (void)power;
+    slots(8);
+    ds18b20_update();
+
+    switch (state)
+    {
+    case STAGE_ROM_COMMAND:
+        if (value == CMD_SKIP_ROM)
+            state = STAGE_FUNCTION;
+        else
+            state = STAGE_DESELECTED;
+        break;
+    case STAGE_FUNCTION:
+        command(value);
+        break;
+    case STAGE_WRITE_SCRATCHPAD:
+        /* TH, TL and the configuration, only the resolution bits of the configuration are writable. */
+        if (SCRATCHPAD_TH + index == SCRATCHPAD_CONFIG)
+            value = (value & 0x60) | 0x1F;
+
+        sensor.scratchpad[SCRATCHPAD_TH + index++] = value;
+        ds18b20_seal();
+        if (SCRATCHPAD_TH + index > SCRATCHPAD_CONFIG)
+            state = STAGE_DESELECTED;
+        break;
+    default:
+        break;
+    }
+}
+
+void OneWire::write_bytes(const uint8_t *buffer, uint16_t count, bool power)
+{
+    for (uint16_t i = 0; i < count; i++)
+        write(buffer[i], power);
+}
+
+uint8_t OneWire::read()
+{
+    slots(8);
+    ds18b20_update();
+
+    if ((state == STAGE_READ_SCRATCHPAD) && (index < HOST_DS18B20_SCRATCHPAD))
+        return host->ds18b20.scratchpad[index++];
+
+    return 0xFF;
+}
+
+void OneWire::read_bytes(uint8_t *buffer, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+        buffer[i] = read();
+}
+
+void OneWire::write_bit(uint8_t value)
+{
+    (void)value;
+    slots(1);
+}
+
+uint8_t OneWire::read_bit()
+{
+    slots(1);
+    ds18b20_update();
+
+    /* The sensor on external power holds the bus low until the conversion is done. */
+    if (host->ds18b20.conversion_end != 0)
+        return 0;
+
+    return 1;
+}
+
+void OneWire::depower()
+{
+}
+
+void OneWire::reset_search()
+{
+    searched = false;
+}
+
+void OneWire::target_search(uint8_t family)
+{
+    searched = (family != DS18B20_FAMILY);
+}
+
+bool OneWire::search(uint8_t *rom, bool search_mode)
+{
+    (void)search_mode;
+
+    /* Reset, search command and three slots for every bit of the ROM code. */
+    host_advance(HOST_ONE_WIRE_RESET_TIME);
+    slots(8 + 64 * 3);
+    state = STAGE_IDLE;
+
+    if (searched)
+    {
+        searched = false;
+        return false;
+    }
+
+    memcpy(rom, host->ds18b20.rom, sizeof(host->ds18b20.rom));
+    searched = true;
+    return true;
+}
+
+uint8_t OneWire::crc8(const uint8_t *addr, uint8_t len)
+{
+    uint8_t crc = 0;
+
+    while (len--)
+    {
+        uint8_t byte = *addr++;
+
+        for (uint8_t i = 8; i; i--)
+        {
+            uint8_t mix = (crc ^ byte) & 0x01;
+
+            crc >>= 1;
+            if (mix)
+                crc ^= 0x8C;
+
+            byte >>= 1;
+        }
+    }
+
+    return crc;
+}
+
+void OneWire::command(uint8_t value)
+{
+    host_ds18b20 &sensor = host->ds18b20;
+
+    switch (value)
+    {
+    case CMD_CONVERT_T:
+        sensor.conversion_end = host->time + (HOST_DS18B20_CONVERSION >> (12 - ds18b20_resolution()));
+        sensor.conversions++;
+        state = STAGE_DESELECTED;
+        break;
+    case CMD_WRITE_SCRATCHPAD:
+        state = STAGE_WRITE_SCRATCHPAD;
+        index = 0;
+        break;
+    case CMD_READ_SCRATCHPAD:
+        state = STAGE_READ_SCRATCHPAD;
+        index = 0;
+        break;
+    case CMD_COPY_SCRATCHPAD:
+        memcpy(sensor.eeprom, &sensor.scratchpad[SCRATCHPAD_TH], sizeof(sensor.eeprom));
+        sensor.eeprom_writes++;
+        host_advance(HOST_DS18B20_COPY_TIME);
+        state = STAGE_DESELECTED;
+        break;
+    case CMD_RECALL_EEPROM:
+        memcpy(&sensor.scratchpad[SCRATCHPAD_TH], sensor.eeprom, sizeof(sensor.eeprom));
+        ds18b20_seal();
+        state = STAGE_DESELECTED;
+        break;
+    case CMD_READ_POWER_SUPPLY:
+        state = STAGE_READ_POWER;
+        break;
+    default:
+        state = STAGE_DESELECTED;
+        break;
+    }
+}
+
+//--------------------------------------------------------------------------------
+
+void host_ds18b20_power_up()
+{
+    host_ds18b20 &sensor = host->ds18b20;
+
+    /* The ROM code is lasered at the factory, the EEPROM keeps the factory defaults until it is written. */
+    if (sensor.rom[0] != DS18B20_FAMILY)
+    {
+        uint32_t serial = host_config->chip_id * 2654435761u;
+
+        sensor.rom[0] = DS18B20_FAMILY;
+        for (int i = 1; i < 7; i++)
+            sensor.rom[i] = (uint8_t)(serial >> (8 * (i % 4))) ^ (uint8_t)i;
+
+        sensor.rom[7] = OneWire::crc8(sensor.rom, 7);
+        sensor.eeprom[0] = 0x4B;
+        sensor.eeprom[1] = 0x46;
+        sensor.eeprom[2] = 0x7F;
+    }
+
+    /* The temperature register holds +85 °C until the first conversion. */
+    sensor.scratchpad[SCRATCHPAD_TEMP_LSB] = 0x50;
+    sensor.scratchpad[SCRATCHPAD_TEMP_MSB] = 0x05;
+    memcpy(&sensor.scratchpad[SCRATCHPAD_TH], sensor.eeprom, sizeof(sensor.eeprom));
+    sensor.scratchpad[5] = 0xFF;
+    sensor.scratchpad[6] = 0x0C;
+    sensor.scratchpad[7] = 0x10;
+    sensor.conversion_end = 0;
+    ds18b20_seal();
+}
+
+/** @brief Finishes the running conversion once its time has passed, the reading is the temperature at its end. */
+static void ds18b20_update()
+{
+    host_ds18b20 &sensor = host->ds18b20;
+
+    if ((sensor.conversion_end == 0) || (host->time < sensor.conversion_end))
+        return;
+
+    /* The undefined low bits of a lower resolution read as zeros. */
+    int16_t raw = (int16_t)lroundf(host_config->environment.temperature(sensor.conversion_end) * 16);
+    raw &= ~((1 << (12 - ds18b20_resolution())) - 1);
+
+    sensor.scratchpad[SCRATCHPAD_TEMP_LSB] = (uint8_t)raw;
+    sensor.scratchpad[SCRATCHPAD_TEMP_MSB] = (uint8_t)(raw >> 8);
+    sensor.conversion_end = 0;
+    ds18b20_seal();
+}
+
+/**
+ * @brief Get the resolution of the configuration register.
+ * @return uint8_t - resolution in bits, 9 to 12
+ */
+static uint8_t ds18b20_resolution()
+{
+    return 9 + ((host->ds18b20.scratchpad[SCRATCHPAD_CONFIG] >> 5) & 0x03);
+}
+
+/** @brief Updates the CRC of the scratchpad. */
+static void ds18b20_seal()
+{
+    host->ds18b20.scratchpad[SCRATCHPAD_CRC] = OneWire::crc8(host->ds18b20.scratchpad, SCRATCHPAD_CRC);
+}
+
+/**
+ * @brief Advances the time by the 1-Wire time slots.
+ * @param [in] count - number of slots
+ */
+static void slots(uint32_t count)
+{
+    host_advance(count * HOST_ONE_WIRE_SLOT_TIME);
+}
@@ -0,0 +1,283 @@
+/**
+ * @file host_wifi.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <ESP8266WiFi.h>
+#include <NTPClient.h>
+#include <lwip/dhcp.h>
+#include "host_hal.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Channel of the access point. */
+#define HOST_AP_CHANNEL         6
+
+/** @brief Signal strength of the access point, in dBm. */
+#define HOST_AP_RSSI            -62
+
+/** @brief RSSI() of a station which is not connected. */
+#define HOST_RSSI_NONE          31
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+static uint8_t ap_bssid[6] = {0x5C, 0x49, 0x7D, 0x12, 0x34, 0x56};
+static struct dhcp lease;
+static bool lease_bound = false;
+
+ESP8266WiFiClass WiFi;
+struct netif *netif_default = nullptr;
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static bool network_up();
+
+//--------------------------------------------------------------------------------
+
+wl_status_t ESP8266WiFiClass::begin(const char *ssid, const char *password, int32_t channel,
+                                    const uint8_t *bssid, bool connect)
+{
+    ssid_matches = (ssid != nullptr) && (strcmp(ssid, host_config->ssid) == 0);
+    credentials = ssid_matches && (strcmp(password ? password : "", host_config->password) == 0);
+    known_ap = (channel != 0) && (bssid != nullptr);
+    ap_matches = known_ap && (channel == HOST_AP_CHANNEL) && (memcmp(bssid, ap_bssid, sizeof(ap_bssid)) == 0);
+    started = connect;
+    state = WL_DISCONNECTED;
+    return state;
+}
+
+wl_status_t ESP8266WiFiClass::begin()
+{
+    started = true;
+    state = WL_DISCONNECTED;
+    return state;
+}
+
+bool ESP8266WiFiClass::config(IPAddress local_ip, IPAddress gateway, IPAddress subnet, IPAddress dns1, IPAddress dns2)
+{
+    (void)dns2;
+
+    /* An all zero address goes back to DHCP. */
+    static_ip = local_ip.isSet();
+    this->ip = local_ip;
+    this->gateway = gateway;
+    this->subnet = subnet;
+    this->dns = dns1;
+    return true;
+}
+
+int8_t ESP8266WiFiClass::waitForConnectResult(unsigned long timeout)
+{
+    uint64_t duration;
+
+    if (!started || (state == WL_CONNECTED))
+        return state;
+
+    /* Without the access point the station scans until the timeout. */
+    if (!network_up() || !ssid_matches || (known_ap && !ap_matches))
+    {
+        host_advance((uint64_t)timeout * 1000);
+        state = WL_NO_SSID_AVAIL;
+        return state;
+    }
+
+    /* The channel and BSSID skip the scan, the static address skips DHCP. */
+    duration = (known_ap && static_ip) ? host_config->fast_connect_time : host_config->connect_time;
+    duration += host_random() % (duration / 5 + 1);
+
+    if (!credentials)
+    {
+        host_advance(std::min<uint64_t>(duration, timeout) * 1000);
+        state = WL_WRONG_PASSWORD;
+        return state;
+    }
+
+    if (duration > timeout)
+    {
+        host_advance((uint64_t)timeout * 1000);
+        state = WL_DISCONNECTED;
+        return state;
+    }
+
+    host_advance(duration * 1000);
+    state = WL_CONNECTED;
+
+    if (!static_ip)
+    {
+        ip = IPAddress(192, 168, 1, 100 + host_config->chip_id % 100);
+        gateway = IPAddress(192, 168, 1, 1);
+        subnet = IPAddress(255, 255, 255, 0);
+        dns = IPAddress(192, 168, 1, 1);
+        lease.offered_t0_lease = host_config->lease;
+        lease.offered_t1_renew = host_config->lease / 2;
+        lease.offered_t2_rebind = host_config->lease / 8 * 7;
+        lease_bound = true;
+    }
+
+    return state;
+}
+
+wl_status_t ESP8266WiFiClass::status()
+{
+    if ((state == WL_CONNECTED) && !network_up())
+        state = WL_CONNECTION_LOST;
+
+    return state;
+}
+
+bool ESP8266WiFiClass::isConnected()
+{
+    return status() == WL_CONNECTED;
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifioff)
+{
+    (void)wifioff;
+    started = false;
+    state = WL_DISCONNECTED;
+    lease_bound = false;
+    return true;
+}
+
+bool ESP8266WiFiClass::mode(WiFiMode_t mode)
+{
+    if (mode == WIFI_OFF)
+        disconnect();
+
+    return true;
+}
+
+bool ESP8266WiFiClass::persistent(bool persistent)
+{
+    (void)persistent;
+    return true;
+}
+
+bool ESP8266WiFiClass::setAutoConnect(bool auto_connect)
+{
+    (void)auto_connect;
+    return true;
+}
+
+bool ESP8266WiFiClass::forceSleepBegin(uint32_t sleep_us)
+{
+    (void)sleep_us;
+    return disconnect();
+}
+
+bool ESP8266WiFiClass::forceSleepWake()
+{
+    return true;
+}
+
+int32_t ESP8266WiFiClass::RSSI()
+{
+    if (!isConnected())
+        return HOST_RSSI_NONE;
+
+    return HOST_AP_RSSI + (int32_t)(host_random() % 5) - 2;
+}
+
+int32_t ESP8266WiFiClass::channel()
+{
+    return isConnected() ? HOST_AP_CHANNEL : 0;
+}
+
+uint8_t *ESP8266WiFiClass::BSSID()
+{
+    static uint8_t none[6];
+
+    return isConnected() ? ap_bssid : none;
+}
+
+IPAddress ESP8266WiFiClass::localIP()
+{
+    return isConnected() ? ip : IPAddress();
+}
+
+IPAddress ESP8266WiFiClass::gatewayIP()
+{
+    return isConnected() ? gateway : IPAddress();
+}
+
+IPAddress ESP8266WiFiClass::subnetMask()
+{
+    return isConnected() ? subnet : IPAddress();
+}
+
+IPAddress ESP8266WiFiClass::dnsIP(uint8_t index)
+{
+    return (isConnected() && (index == 0)) ? dns : IPAddress();
+}
+
+struct dhcp *netif_dhcp_data(struct netif *netif)
+{
+    (void)netif;
+    return lease_bound ? &lease : nullptr;
+}
+
+//--------------------------------------------------------------------------------
+
+NTPClient::NTPClient(WiFiUDP &udp, const char *server, long offset, unsigned long interval)
+    : offset(offset), interval(interval), epoch(0), update_time(0)
+{
+    (void)udp;
+    (void)server;
+}
+
+void NTPClient::begin()
+{
+}
+
+void NTPClient::end()
+{
+}
+
+bool NTPClient::update()
+{
+    if (isTimeSet() && (millis() - update_time < interval))
+        return true;
+
+    return forceUpdate();
+}
+
+bool NTPClient::forceUpdate()
+{
+    if (!WiFi.isConnected())
+    {
+        host_advance((uint64_t)HOST_NTP_TIMEOUT * 1000);
+        return false;
+    }
+
+    host_advance((uint64_t)HOST_NTP_TIME * 1000);
+    epoch = host->time / 1000000;
+    update_time = millis();
+    return true;
+}
+
+bool NTPClient::isTimeSet() const
+{
+    return update_time != 0;
+}
+
+unsigned long NTPClient::getEpochTime() const
+{
+    return offset + epoch + (millis() - update_time) / 1000;
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Checks the access point and the internet.
+ * @return true if the network of the environment is up at the current time, otherwise false
+ */
+static bool network_up()
+{
+    return host_config->environment.network(host->time);
+}
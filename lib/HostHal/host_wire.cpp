@@ -0,0 +1,447 @@
+/**
+ * @file host_wire.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <Wire.h>
+#include "host_hal.h"
+
+//--------------------------------------------------------------------------------
+
+#ifndef M_PI
+    #define M_PI 3.14159265358979323846
+#endif
+
+/** @brief I2C address of the MPU6050, AD0 low. */
+#define HOST_MPU6050_ADDRESS        0x68
+
+/* Registers of the MPU6050 used by the model, from the register map of the sensor. */
+#define REG_SMPLRT_DIV              0x19
+#define REG_CONFIG                  0x1A
+#define REG_ACCEL_CONFIG            0x1C
+#define REG_MOT_THR                 0x1F
+#define REG_FIFO_EN                 0x23
+#define REG_INT_ENABLE              0x38
+#define REG_INT_STATUS              0x3A
+#define REG_ACCEL_XOUT_H            0x3B
+#define REG_TEMP_OUT_H              0x41
+#define REG_EXT_SENS_DATA_23        0x60
+#define REG_USER_CTRL               0x6A
+#define REG_PWR_MGMT_1              0x6B
+#define REG_PWR_MGMT_2              0x6C
+#define REG_FIFO_COUNTH             0x72
+#define REG_FIFO_COUNTL             0x73
+#define REG_FIFO_R_W                0x74
+#define REG_WHO_AM_I                0x75
+
+/* Bits of the registers. */
+#define FIFO_EN_ACCEL               (1 << 3)
+#define INT_MOT                     (1 << 6)
+#define INT_FIFO_OFLOW              (1 << 4)
+#define INT_DATA_RDY                (1 << 0)
+#define USER_CTRL_FIFO_EN           (1 << 6)
+#define USER_CTRL_FIFO_RESET        (1 << 2)
+#define USER_CTRL_RESETS            0x07
+#define PWR_MGMT_1_DEVICE_RESET     (1 << 7)
+#define PWR_MGMT_1_SLEEP            (1 << 6)
+#define PWR_MGMT_1_CYCLE            (1 << 5)
+#define PWR_MGMT_1_TEMP_DIS         (1 << 3)
+
+/** @brief Size of an accelerometer sample in the FIFO, in bytes. */
+#define HOST_MPU6050_SAMPLE_SIZE    6
+
+/** @brief Period of the swinging of a disturbed hydrometer, in us. */
+#define HOST_SWING_PERIOD           1300000
+
+/** @brief Rotation of the hydrometer around its long axis, it spreads the tilt over X and Z, in degrees. */
+#define HOST_ROLL                   20
+
+/** @brief One LSB of MOT_THR, in g. */
+#define HOST_MOT_THR_LSB            0.002f
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+/** @brief Sample periods of the low power cycle mode by LP_WAKE_CTRL, in us. */
+static const uint64_t cycle_periods[] = {800000, 200000, 50000, 25000};
+
+TwoWire Wire;
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static void mpu6050_update();
+static void mpu6050_sample(uint64_t time);
+static uint64_t mpu6050_period();
+static void mpu6050_write(uint8_t reg, uint8_t value);
+static uint8_t mpu6050_read(uint8_t reg);
+static void fifo_push(uint8_t value);
+static void bus_transfer(size_t bytes, uint32_t frequency);
+
+//--------------------------------------------------------------------------------
+
+void TwoWire::begin(int sda, int scl)
+{
+    (void)sda;
+    (void)scl;
+    begin();
+}
+
+void TwoWire::begin()
+{
+    tx_length = 0;
+    rx_length = 0;
+    rx_index = 0;
+}
+
+uint8_t TwoWire::status()
+{
+    return I2C_OK;
+}
+
+void TwoWire::setClock(uint32_t frequency)
+{
+    this->frequency = frequency;
+}
+
+void TwoWire::setClockStretchLimit(uint32_t limit)
+{
+    (void)limit;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+    this->address = address;
+    tx_length = 0;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t send_stop)
+{
+    (void)send_stop;
+
+    bus_transfer(tx_length, frequency);
+    if (address != HOST_MPU6050_ADDRESS)
+        return 2;
+
+    host->mpu6050.transactions++;
+    mpu6050_update();
+
+    if (tx_length == 0)
+        return 0;
+
+    /* The first byte sets the register address, the next ones are written from it on. */
+    host->mpu6050.pointer = tx[0];
+    for (size_t i = 1; i < tx_length; i++)
+    {
+        mpu6050_write(host->mpu6050.pointer, tx[i]);
+        if (host->mpu6050.pointer != REG_FIFO_R_W)
+            host->mpu6050.pointer = (host->mpu6050.pointer + 1) % HOST_MPU6050_REGISTERS;
+    }
+
+    tx_length = 0;
+    return 0;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+    if (tx_length >= BUFFER_LENGTH)
+        return 0;
+
+    tx[tx_length++] = data;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+    for (size_t i = 0; i < quantity; i++)
+    {
+        if (!write(data[i]))
+            return i;
+    }
+
+    return quantity;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t size, bool send_stop)
+{
+    (void)send_stop;
+
+    size = std::min<size_t>(size, BUFFER_LENGTH);
+    rx_length = 0;
+    rx_index = 0;
+
+    bus_transfer(size, frequency);
+    if (address != HOST_MPU6050_ADDRESS)
+        return 0;
+
+    host->mpu6050.transactions++;
+    mpu6050_update();
+
+    /* FIFO_R_W does not increment the address, a burst drains the FIFO. */
+    for (size_t i = 0; i < size; i++)
+    {
+        rx[rx_length++] = mpu6050_read(host->mpu6050.pointer);
+        if (host->mpu6050.pointer != REG_FIFO_R_W)
+            host->mpu6050.pointer = (host->mpu6050.pointer + 1) % HOST_MPU6050_REGISTERS;
+    }
+
+    return rx_length;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity)
+{
+    return requestFrom(address, (size_t)quantity, true);
+}
+
+uint8_t TwoWire::requestFrom(int address, int quantity)
+{
+    return requestFrom((uint8_t)address, (size_t)quantity, true);
+}
+
+int TwoWire::available()
+{
+    return rx_length - rx_index;
+}
+
+int TwoWire::read()
+{
+    return (rx_index < rx_length) ? rx[rx_index++] : -1;
+}
+
+int TwoWire::peek()
+{
+    return (rx_index < rx_length) ? rx[rx_index] : -1;
+}
+
+//--------------------------------------------------------------------------------
+
+void host_mpu6050_power_up()
+{
+    host_mpu6050 &mpu = host->mpu6050;
+
+    memset(mpu.registers, 0, sizeof(mpu.registers));
+    mpu.registers[REG_PWR_MGMT_1] = PWR_MGMT_1_SLEEP;
+    mpu.registers[REG_WHO_AM_I] = HOST_MPU6050_ADDRESS;
+    mpu.fifo_head = 0;
+    mpu.fifo_count = 0;
+    mpu.pointer = 0;
+    mpu.samples = 0;
+    mpu.sample_time = host->time;
+    mpu.update_time = host->time;
+}
+
+/**
+ * @brief Takes the samples due since the last access, the sensor samples on its own also during deep sleep.
+ *        After a long gap only the samples which can still be observed are taken, unless the motion
+ *        detection needs all of them.
+ */
+static void mpu6050_update()
+{
+    host_mpu6050 &mpu = host->mpu6050;
+    uint64_t period = mpu6050_period();
+    uint64_t now = host->time;
+
+    if (mpu.registers[REG_PWR_MGMT_1] & PWR_MGMT_1_SLEEP)
+    {
+        mpu.sample_time = now + period;
+        mpu.update_time = now;
+        return;
+    }
+
+    if (!(mpu.registers[REG_INT_ENABLE] & INT_MOT) && (mpu.sample_time + period < now))
+    {
+        uint64_t observed = (HOST_MPU6050_FIFO_SIZE / HOST_MPU6050_SAMPLE_SIZE + 1) * period;
+
+        if (now - mpu.sample_time > observed)
+            mpu.sample_time += (now - mpu.sample_time - observed) / period * period;
+    }
+
+    while (mpu.sample_time <= now)
+    {
+        mpu6050_sample(mpu.sample_time);
+        mpu.sample_time += period;
+    }
+
+    mpu.update_time = now;
+}
+
+/**
+ * @brief Takes a sample at the time, the hydrometer floats at the tilt of the environment and swings when disturbed.
+ * @param [in] time - time of the sample, in us since epoch
+ */
+static void mpu6050_sample(uint64_t time)
+{
+    host_mpu6050 &mpu = host->mpu6050;
+    uint8_t *registers = mpu.registers;
+    const host_environment &environment = host_config->environment;
+    float swing = environment.swing(time) * sinf(2 * M_PI * (time % HOST_SWING_PERIOD) / HOST_SWING_PERIOD);
+    float tilt = (environment.tilt(time) + swing + host_config->tilt_noise * host_random_normal()) * M_PI / 180;
+    float roll = HOST_ROLL * M_PI / 180;
+    float accel[3] = {sinf(tilt) * cosf(roll), cosf(tilt), sinf(tilt) * sinf(roll)};
+    float lsb = 16384 >> ((registers[REG_ACCEL_CONFIG] >> 3) & 0x03);
+    float change = 0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        int16_t previous = (int16_t)((registers[REG_ACCEL_XOUT_H + 2 * i] << 8) | registers[REG_ACCEL_XOUT_H + 2 * i + 1]);
+        int16_t value = (int16_t)constrain(lroundf(accel[i] * lsb), -32768L, 32767L);
+
+        change += ((value - previous) / lsb) * ((value - previous) / lsb);
+        registers[REG_ACCEL_XOUT_H + 2 * i] = (uint8_t)(value >> 8);
+        registers[REG_ACCEL_XOUT_H + 2 * i + 1] = (uint8_t)value;
+    }
+
+    if (!(registers[REG_PWR_MGMT_1] & PWR_MGMT_1_TEMP_DIS))
+    {
+        int16_t temperature = (int16_t)lroundf((environment.temperature(time) - 36.53f) * 340);
+
+        registers[REG_TEMP_OUT_H] = (uint8_t)(temperature >> 8);
+        registers[REG_TEMP_OUT_H + 1] = (uint8_t)temperature;
+    }
+
+    if ((registers[REG_USER_CTRL] & USER_CTRL_FIFO_EN) && (registers[REG_FIFO_EN] & FIFO_EN_ACCEL) &&
+        !(registers[REG_PWR_MGMT_1] & PWR_MGMT_1_CYCLE))
+    {
+        for (int i = 0; i < HOST_MPU6050_SAMPLE_SIZE; i++)
+            fifo_push(registers[REG_ACCEL_XOUT_H + i]);
+    }
+
+    /* The high-pass filtered acceleration is the change since the previous sample. */
+    if ((registers[REG_INT_ENABLE] & INT_MOT) && (mpu.samples > 0) &&
+        (sqrtf(change) > registers[REG_MOT_THR] * HOST_MOT_THR_LSB))
+        registers[REG_INT_STATUS] |= INT_MOT;
+
+    registers[REG_INT_STATUS] |= INT_DATA_RDY;
+    mpu.samples++;
+}
+
+/**
+ * @brief Get the sample period of the current configuration.
+ * @return uint64_t - period in us
+ */
+static uint64_t mpu6050_period()
+{
+    const uint8_t *registers = host->mpu6050.registers;
+    uint8_t dlpf = registers[REG_CONFIG] & 0x07;
+
+    if (registers[REG_PWR_MGMT_1] & PWR_MGMT_1_CYCLE)
+        return cycle_periods[registers[REG_PWR_MGMT_2] >> 6];
+
+    /* The gyroscope output rate is 8 kHz without the low pass filter, 1 kHz with it. */
+    uint32_t rate = ((dlpf == 0) || (dlpf == 7)) ? 8000 : 1000;
+    return 1000000ULL * (1 + registers[REG_SMPLRT_DIV]) / rate;
+}
+
+/**
+ * @brief Writes the register, with the side effects of the sensor.
+ * @param [in] reg - register address
+ * @param [in] value - written value
+ */
+static void mpu6050_write(uint8_t reg, uint8_t value)
+{
+    host_mpu6050 &mpu = host->mpu6050;
+
+    switch (reg)
+    {
+    case REG_INT_STATUS:
+    case REG_FIFO_COUNTH:
+    case REG_FIFO_COUNTL:
+    case REG_FIFO_R_W:
+    case REG_WHO_AM_I:
+        return;
+    case REG_USER_CTRL:
+        /* The reset is triggered only while the FIFO is disabled, the reset bits clear themselves. */
+        if ((value & USER_CTRL_FIFO_RESET) && !(value & USER_CTRL_FIFO_EN))
+        {
+            mpu.fifo_head = 0;
+            mpu.fifo_count = 0;
+        }
+
+        mpu.registers[reg] = value & ~USER_CTRL_RESETS;
+        return;
+    case REG_PWR_MGMT_1:
+        if (value & PWR_MGMT_1_DEVICE_RESET)
+        {
+            host_mpu6050_power_up();
+            return;
+        }
+        break;
+    default:
+        /* Measurements are read only. */
+        if ((reg >= REG_ACCEL_XOUT_H) && (reg <= REG_EXT_SENS_DATA_23))
+            return;
+        break;
+    }
+
+    mpu.registers[reg] = value;
+
+    /* A faster rate starts with its first period, the sample in progress at a slower rate is finished. */
+    if ((reg == REG_SMPLRT_DIV) || (reg == REG_CONFIG) || (reg == REG_PWR_MGMT_1) || (reg == REG_PWR_MGMT_2))
+        mpu.sample_time = std::min(mpu.sample_time, host->time + mpu6050_period());
+}
+
+/**
+ * @brief Reads the register, with the side effects of the sensor.
+ * @param [in] reg - register address
+ * @return uint8_t - value
+ */
+static uint8_t mpu6050_read(uint8_t reg)
+{
+    host_mpu6050 &mpu = host->mpu6050;
+    uint8_t value;
+
+    switch (reg)
+    {
+    case REG_INT_STATUS:
+        value = mpu.registers[reg];
+        mpu.registers[reg] = 0;
+        return value;
+    case REG_FIFO_COUNTH:
+        return mpu.fifo_count >> 8;
+    case REG_FIFO_COUNTL:
+        return (uint8_t)mpu.fifo_count;
+    case REG_FIFO_R_W:
+        if (mpu.fifo_count == 0)
+            return 0;
+
+        value = mpu.fifo[mpu.fifo_head];
+        mpu.fifo_head = (mpu.fifo_head + 1) % HOST_MPU6050_FIFO_SIZE;
+        mpu.fifo_count--;
+        return value;
+    default:
+        return mpu.registers[reg];
+    }
+}
+
+/**
+ * @brief Appends the byte to the FIFO, a full FIFO overwrites its oldest byte.
+ * @param [in] value - byte
+ */
+static void fifo_push(uint8_t value)
+{
+    host_mpu6050 &mpu = host->mpu6050;
+
+    if (mpu.fifo_count == HOST_MPU6050_FIFO_SIZE)
+    {
+        mpu.fifo_head = (mpu.fifo_head + 1) % HOST_MPU6050_FIFO_SIZE;
+        mpu.fifo_count--;
+        mpu.registers[REG_INT_STATUS] |= INT_FIFO_OFLOW;
+    }
+
+    mpu.fifo[(mpu.fifo_head + mpu.fifo_count) % HOST_MPU6050_FIFO_SIZE] = value;
+    mpu.fifo_count++;
+}
+
+/**
+ * @brief Advances the time by a transfer: start, address, the bytes each with its acknowledge and stop.
+ * @param [in] bytes - bytes after the address
+ * @param [in] frequency - clock of the bus, in Hz
+ */
+static void bus_transfer(size_t bytes, uint32_t frequency)
+{
+    host_advance((9 * (bytes + 1) + 2) * 1000000ULL / frequency);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file dhcp.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_LWIP_DHCP_H_
+#define HOST_LWIP_DHCP_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief DHCP client state of an interface, the fields read by the firmware. */
+struct dhcp
+{
+    uint32_t offered_t0_lease;  /**< Lease time offered by the server, in seconds. */
+    uint32_t offered_t1_renew;  /**< Renewal time offered by the server, in seconds. */
+    uint32_t offered_t2_rebind; /**< Rebinding time offered by the server, in seconds. */
+};
+
+/** @brief Network interface. */
+struct netif;
+
+/** @brief Interface of the station. */
+extern struct netif *netif_default;
+
+/**
+ * @brief Get the DHCP client of the interface.
+ * @return struct dhcp* - client, nullptr if the address is static
+ */
+struct dhcp *netif_dhcp_data(struct netif *netif);
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_LWIP_DHCP_H_ */
@@ -111,6 +111,17 @@ mpu6050_accel_config_afs_sel MPU6050::get_accel_range(void)
     return (mpu6050_accel_config_afs_sel)temp_register;
 }
 
+void MPU6050::set_accel_hpf(mpu6050_accel_config_accel_hpf accel_hpf)
+{
+    write_register_byte(MPU6050_REGISTER_ACCEL_CONFIG, accel_hpf, MPU6050_ACCEL_CONFIG_HPF_POSITION, MPU6050_ACCEL_CONFIG_HPF_BITMASK);
+}
+
+mpu6050_accel_config_accel_hpf MPU6050::get_accel_hpf(void)
+{
+    read_register_byte(MPU6050_REGISTER_ACCEL_CONFIG, &temp_register, MPU6050_ACCEL_CONFIG_HPF_POSITION, MPU6050_ACCEL_CONFIG_HPF_BITMASK);
+    return (mpu6050_accel_config_accel_hpf)temp_register;
+}
+
 void MPU6050::set_accel_x_self_test(bool state)
 {
     write_register_bit(MPU6050_REGISTER_ACCEL_CONFIG, MPU6050_ACCEL_CONFIG_XA_ST, state);
@@ -144,6 +155,31 @@ bool MPU6050::get_accel_z_self_test(void)
     return temp_register_bit_state;
 }
 
+//------------------------------------------------------------------------
+/* MOT_THR (0x1F) and MOT_DUR (0x20) registers. */
+
+void MPU6050::set_mot_threshold(uint8_t threshold)
+{
+    write_register_byte(MPU6050_REGISTER_MOT_THRESHOLD, threshold);
+}
+
+uint8_t MPU6050::get_mot_threshold(void)
+{
+    read_register_byte(MPU6050_REGISTER_MOT_THRESHOLD, &temp_register);
+    return temp_register;
+}
+
+void MPU6050::set_mot_duration(uint8_t duration)
+{
+    write_register_byte(MPU6050_REGISTER_MOT_DURATION, duration);
+}
+
+uint8_t MPU6050::get_mot_duration(void)
+{
+    read_register_byte(MPU6050_REGISTER_MOT_DURATION, &temp_register);
+    return temp_register;
+}
+
 //------------------------------------------------------------------------
 /* FIFO_EN (0x23) register */
 
@@ -348,6 +384,17 @@ void MPU6050::set_int_enable_fifo_oflow(bool state)
     write_register_bit(MPU6050_REGISTER_INT_ENABLE, MPU6050_INT_ENABLE_FIFO_OFLOW_EN, state);
 }
 
+void MPU6050::set_int_enable_mot(bool state)
+{
+    write_register_bit(MPU6050_REGISTER_INT_ENABLE, MPU6050_INT_ENABLE_MOT_EN, state);
+}
+
+bool MPU6050::get_int_enable_mot(void)
+{
+    read_register_bit(MPU6050_REGISTER_INT_ENABLE, MPU6050_INT_ENABLE_MOT_EN, &temp_register_bit_state);
+    return temp_register_bit_state;
+}
+
 bool MPU6050::get_int_enable_fifo_oflow(void)
 {
     read_register_bit(MPU6050_REGISTER_INT_ENABLE, MPU6050_INT_ENABLE_FIFO_OFLOW_EN, &temp_register_bit_state);
@@ -375,23 +422,25 @@ bool MPU6050::get_int_status_fifo_oflow(void)
     return temp_register_bit_state;
 }
 
+bool MPU6050::get_int_status_mot(void)
+{
+    read_register_bit(MPU6050_REGISTER_INT_STATUS, MPU6050_INT_STATUS_MOT_INT, &temp_register_bit_state);
+    return temp_register_bit_state;
+}
+
 //------------------------------------------------------------------------
 /* Accelerometer measurements, 0x3B to 0x40 registers (Read only)  */ 
 
 vector MPU6050::get_accel_data(void)
 {
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    if (!Wire.write(MPU6050_REGISTER_ACCEL_XOUT_H) || (Wire.endTransmission() == 2))
-        return MPU6050_VECTOR_READ_ERROR;
+    uint8_t buffer[6];
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.requestFrom(MPU6050_DEFAULT_ADRESS, 6);
+    if (!read_registers(MPU6050_REGISTER_ACCEL_XOUT_H, buffer, sizeof(buffer)))
+        return MPU6050_VECTOR_READ_ERROR;
 
-    while (Wire.available() < 6);
-    
-    accel_data.x_axis = (int16_t)(Wire.read() << 8) | Wire.read();
-    accel_data.y_axis = (int16_t)(Wire.read() << 8) | Wire.read();
-    accel_data.z_axis = (int16_t)(Wire.read() << 8) | Wire.read();
+    accel_data.x_axis = (int16_t)((buffer[0] << 8) | buffer[1]);
+    accel_data.y_axis = (int16_t)((buffer[2] << 8) | buffer[3]);
+    accel_data.z_axis = (int16_t)((buffer[4] << 8) | buffer[5]);
 
     return accel_data;
 }
@@ -426,18 +475,14 @@ int16_t MPU6050::get_temperature(void)
 
 vector MPU6050::get_gyro_data(void)
 {
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.write(MPU6050_REGISTER_GYRO_XOUT_H);
-    Wire.endTransmission();
+    uint8_t buffer[6];
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.requestFrom(MPU6050_DEFAULT_ADRESS, 6);
+    if (!read_registers(MPU6050_REGISTER_GYRO_XOUT_H, buffer, sizeof(buffer)))
+        return MPU6050_VECTOR_READ_ERROR;
 
-    while(Wire.available() < 6);
-    
-    gyro_data.x_axis = (int16_t)(Wire.read() << 8) | Wire.read();
-    gyro_data.y_axis = (int16_t)(Wire.read() << 8) | Wire.read();
-    gyro_data.z_axis = (int16_t)(Wire.read() << 8) | Wire.read();
+    gyro_data.x_axis = (int16_t)((buffer[0] << 8) | buffer[1]);
+    gyro_data.y_axis = (int16_t)((buffer[2] << 8) | buffer[3]);
+    gyro_data.z_axis = (int16_t)((buffer[4] << 8) | buffer[5]);
 
     return gyro_data;
 }
@@ -693,6 +738,55 @@ uint8_t MPU6050::fifo_read(void)
     return temp_register;
 }
 
+size_t MPU6050::fifo_read_burst(uint8_t *buffer, size_t len)
+{
+    size_t count = 0;
+
+    while (count < len)
+    {
+        size_t chunk = read_fifo_chunk((len - count) < MPU6050_WIRE_BUFFER_LENGTH ? (len - count) : MPU6050_WIRE_BUFFER_LENGTH);
+        if (chunk == 0)
+            break;
+
+        for (size_t i = 0; i < chunk; i++)
+            buffer[count++] = Wire.read();
+    }
+
+    return count;
+}
+
+size_t MPU6050::read_accel_samples(vector *samples, size_t max)
+{
+    const size_t chunk_samples = MPU6050_WIRE_BUFFER_LENGTH / MPU6050_FIFO_ACCEL_SAMPLE_SIZE;
+    size_t available = get_fifo_count() / MPU6050_FIFO_ACCEL_SAMPLE_SIZE;
+    size_t count = 0;
+
+    if (available < max)
+        max = available;
+
+    while (count < max)
+    {
+        size_t chunk = (max - count) < chunk_samples ? (max - count) : chunk_samples;
+        if (read_fifo_chunk(chunk * MPU6050_FIFO_ACCEL_SAMPLE_SIZE) != chunk * MPU6050_FIFO_ACCEL_SAMPLE_SIZE)
+            break;
+
+        /* Samples are decoded straight from the Wire buffer, big-endian X, Y, Z. */
+        for (size_t i = 0; i < chunk; i++, count++)
+        {
+            uint8_t high;
+
+            high = Wire.read();
+            samples[count].x_axis = (int16_t)((high << 8) | Wire.read());
+            high = Wire.read();
+            samples[count].y_axis = (int16_t)((high << 8) | Wire.read());
+            high = Wire.read();
+            samples[count].z_axis = (int16_t)((high << 8) | Wire.read());
+        }
+    }
+
+    return count;
+}
+
 //------------------------------------------------------------------------
 /* WHO_AM_I (0x75) register (Read only) */
 
@@ -702,63 +796,162 @@ uint8_t MPU6050::get_who_am_i(void)
 }
 
 //------------------------------------------------------------------------
+/* I2C interface. */
 
-bool MPU6050::write_register_byte(uint8_t reg, uint8_t value, uint8_t position, uint8_t bitmask)
+uint8_t MPU6050::begin(uint8_t pin_sda, uint8_t pin_scl)
 {
-    uint8_t temp_value = 0;
+    uint8_t status;
 
-    if(!read_register_byte(reg, &temp_value))
-        return false;
-    
-    if (bitmask)
+    this->pin_sda = pin_sda;
+    this->pin_scl = pin_scl;
+
+    Wire.begin(pin_sda, pin_scl);
+    Wire.setClockStretchLimit(MPU6050_I2C_CLOCK_STRETCH_LIMIT);
+
+    status = Wire.status();
+    if (status != I2C_OK)
     {
-        temp_value &= bitmask;
-        temp_value |= (value << position);
+        recover_bus();
+        status = Wire.status();
     }
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.write(reg);
-    Wire.write(temp_value);
-    Wire.endTransmission();
+    return status;
+}
 
-    return true;
+const mpu6050_i2c_stats &MPU6050::get_i2c_stats(void)
+{
+    return i2c_stats;
 }
 
-bool MPU6050::write_register_byte(uint8_t reg, uint8_t value)
+//------------------------------------------------------------------------
+/* Shadow copy of the configuration registers. */
+
+bool MPU6050::commit(void)
 {
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    if (!Wire.write(reg))
+    bool status = true;
+
+    for (uint8_t reg = 0; reg < MPU6050_SHADOW_SIZE; reg++)
+    {
+        uint8_t len = 0;
+
+        while (((reg + len) < MPU6050_SHADOW_SIZE) && (shadow_dirty[(reg + len) / 32] & (1UL << ((reg + len) % 32))))
+            len++;
+
+        if (len == 0)
+            continue;
+
+        /* The register address is incremented by the sensor after each written byte. */
+        bool written = write_registers(reg, &shadow[reg], len);
+        status &= written;
+
+        /* A failed run is retried by the next commit, until then the next access reads the sensor again. */
+        for (uint8_t i = 0; i < len; i++)
+        {
+            if (written)
+                shadow_dirty[(reg + i) / 32] &= ~(1UL << ((reg + i) % 32));
+            else
+                shadow_valid[(reg + i) / 32] &= ~(1UL << ((reg + i) % 32));
+        }
+
+        reg += len;
+    }
+
+    /* Reset bits are cleared by the sensor. */
+    shadow[MPU6050_REGISTER_USER_CTRL] &= ~((1 << MPU6050_USER_CTRL_FIFO_RESET) | (1 << MPU6050_USER_CTRL_I2C_MST_RESET) |
+                                            (1 << MPU6050_USER_CTRL_SIG_COND_RESET));
+
+    /* Device reset restores the default value of all registers. */
+    if (shadow[MPU6050_REGISTER_PWR_MGMT_1] & (1 << MPU6050_PWR_MGMT_1_DEVICE_RESET))
+    {
+        for (uint8_t i = 0; i < MPU6050_SHADOW_SIZE / 32; i++)
+            shadow_valid[i] = 0;
+    }
+
+    return status;
+}
+
+bool MPU6050::is_shadowed(uint8_t reg)
+{
+    switch (reg)
+    {
+    case MPU6050_REGISTER_SMPLRT_DIV:
+    case MPU6050_REGISTER_CONFIG:
+    case MPU6050_REGISTER_GYRO_CONFIG:
+    case MPU6050_REGISTER_ACCEL_CONFIG:
+    case MPU6050_REGISTER_MOT_THRESHOLD:
+    case MPU6050_REGISTER_MOT_DURATION:
+    case MPU6050_REGISTER_FIFO_EN:
+    case MPU6050_REGISTER_INT_PIN_CFG:
+    case MPU6050_REGISTER_INT_ENABLE:
+    case MPU6050_REGISTER_MOT_DETECT_CTRL:
+    case MPU6050_REGISTER_USER_CTRL:
+    case MPU6050_REGISTER_PWR_MGMT_1:
+    case MPU6050_REGISTER_PWR_MGMT_2:
+        return true;
+    default:
         return false;
+    }
+}
 
-    Wire.write(value);
-    Wire.endTransmission();
+bool MPU6050::shadow_read(uint8_t reg, uint8_t *value)
+{
+    /* The register is read from the sensor only on the first access. */
+    if (!(shadow_valid[reg / 32] & (1UL << (reg % 32))))
+    {
+        if (!read_registers(reg, &shadow[reg], 1))
+            return false;
+
+        shadow_valid[reg / 32] |= (1UL << (reg % 32));
+    }
 
+    *value = shadow[reg];
     return true;
 }
 
-bool MPU6050::read_register_byte(uint8_t reg, uint8_t *value, uint8_t position, uint8_t bitmask)
+void MPU6050::shadow_write(uint8_t reg, uint8_t value)
 {
-    if((reg == 0) || (value == NULL))
-        return false;
+    if ((shadow_valid[reg / 32] & (1UL << (reg % 32))) && (shadow[reg] == value))
+        return;
+
+    shadow[reg] = value;
+    shadow_valid[reg / 32] |= (1UL << (reg % 32));
+    shadow_dirty[reg / 32] |= (1UL << (reg % 32));
+}
 
+//------------------------------------------------------------------------
+
+bool MPU6050::write_register_byte(uint8_t reg, uint8_t value, uint8_t position, uint8_t bitmask)
+{
     uint8_t temp_value = 0;
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    if (!Wire.write(reg))
+    if(!read_register_byte(reg, &temp_value))
         return false;
+    
+    if (bitmask)
+    {
+        temp_value &= bitmask;
+        temp_value |= (value << position);
+    }
 
-    if (Wire.endTransmission() == 2) // if received NACK on transmit of address
-        return false;
+    return write_register_byte(reg, temp_value);
+}
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.requestFrom(MPU6050_DEFAULT_ADRESS, 1);
+bool MPU6050::write_register_byte(uint8_t reg, uint8_t value)
+{
+    if (is_shadowed(reg))
+    {
+        shadow_write(reg, value);
+        return true;
+    }
 
-    while(!Wire.available());
+    return write_registers(reg, &value, 1);
+}
 
-    temp_value = Wire.read();
-    Wire.endTransmission();
+bool MPU6050::read_register_byte(uint8_t reg, uint8_t *value, uint8_t position, uint8_t bitmask)
+{
+    uint8_t temp_value = 0;
 
-    if (temp_value == -1)
+    if (!read_register_byte(reg, &temp_value))
         return false;
 
     if (bitmask)
@@ -771,27 +964,15 @@ bool MPU6050::read_register_byte(uint8_t reg, uint8_t *value, uint8_t position,
     return true;
 }
 
-
 bool MPU6050::read_register_byte(uint8_t reg, uint8_t *value)
 {
     if((reg == 0) || (value == NULL))
         return false;
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    if (Wire.write(reg) == 0)
-        return false;
+    if (is_shadowed(reg))
+        return shadow_read(reg, value);
 
-    if (Wire.endTransmission() == 2) // if received NACK on transmit of address
-        return false;
-
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.requestFrom(MPU6050_DEFAULT_ADRESS, 1);
-
-    while(!Wire.available());
-
-    *value = Wire.read();
-    Wire.endTransmission();
-    return true;
+    return read_registers(reg, value, 1);
 }
 
 bool MPU6050::write_register_bit(uint8_t reg, uint8_t position, bool state)
@@ -802,12 +983,7 @@ bool MPU6050::write_register_bit(uint8_t reg, uint8_t position, bool state)
 
     state ? temp_value |= (1 << position) : temp_value &= ~(1 << position);
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.write(reg);
-    Wire.write(temp_value);
-    Wire.endTransmission();
-
-    return true;
+    return write_register_byte(reg, temp_value);
 }
 
 bool MPU6050::read_register_bit(uint8_t reg, uint8_t position, bool *state)
@@ -824,39 +1000,142 @@ bool MPU6050::read_register_bit(uint8_t reg, uint8_t position, bool *state)
 
 bool MPU6050::read_register_word(uint8_t reg, uint16_t *value)
 {
+    uint8_t buffer[2];
+
     if ((reg == 0) || (value == NULL))
         return false;
-    
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    if (!Wire.write(reg))
-        return false;
 
-    if (Wire.endTransmission() == 2) // if received NACK on transmit of address
+    if (!read_registers(reg, buffer, sizeof(buffer)))
         return false;
 
-    Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
-    Wire.requestFrom(MPU6050_DEFAULT_ADRESS, 2);
-    while (!Wire.available());
+    *value = (buffer[0] << 8) | buffer[1];
+    return true;
+}
+
+/**
+ * @brief Reads consecutive registers, bypassing the shadow copy. Failed transactions are retried.
+ * @return true if all bytes were received, otherwise false.
+ */
+bool MPU6050::read_registers(uint8_t reg, uint8_t *buffer, uint8_t len)
+{
+    if (!execute(reg, NULL, 0, len, MPU6050_I2C_ATTEMPTS_MAX))
+        return false;
 
-    *value = Wire.read() << 8 | Wire.read();
+    for (uint8_t i = 0; i < len; i++)
+        buffer[i] = Wire.read();
 
-    Wire.endTransmission();
     return true;
 }
 
-bool MPU6050::write_register_word(uint8_t reg, uint16_t value)
+/**
+ * @brief Writes consecutive registers, bypassing the shadow copy. Failed transactions are retried.
+ * @return true if the transaction was acknowledged, otherwise false.
+ */
+bool MPU6050::write_registers(uint8_t reg, const uint8_t *buffer, uint8_t len)
 {
-    if (!reg)
-        return false;
+    return execute(reg, buffer, len, 0, MPU6050_I2C_ATTEMPTS_MAX);
+}
+
+/**
+ * @brief Reads FIFO_R_W register in a single transaction, the data is left in the Wire buffer.
+ * @note  Not retried, the bytes of a failed read may have already been removed from the FIFO.
+ * @param [in] len - number of bytes to read, at most MPU6050_WIRE_BUFFER_LENGTH
+ * @return size_t - number of bytes available in the Wire buffer, 0 on error
+ */
+size_t MPU6050::read_fifo_chunk(uint8_t len)
+{
+    return execute(MPU6050_REGISTER_FIFO_R_W, NULL, 0, len, 1) ? len : 0;
+}
+
+/**
+ * @brief Runs a transaction, retrying it with bus recovery in between while the retry budget lasts.
+ * @return true if successful, otherwise false.
+ */
+bool MPU6050::execute(uint8_t reg, const uint8_t *tx, uint8_t tx_len, uint8_t rx_len, uint8_t attempts)
+{
+    uint32_t start = micros();
+    uint32_t latency;
+    uint8_t error;
+
+    for (;;)
+    {
+        error = transfer(reg, tx, tx_len, rx_len);
+        if (error == MPU6050_I2C_OK)
+            break;
+
+        i2c_stats.errors++;
+        i2c_stats.last_error = error;
+
+        if ((--attempts == 0) || (i2c_stats.retries >= MPU6050_I2C_RETRY_BUDGET))
+            break;
+
+        i2c_stats.retries++;
+        recover_bus();
+    }
+
+    latency = micros() - start;
+    i2c_stats.transactions++;
+    i2c_stats.latency_total += latency;
+    if (latency > i2c_stats.latency_max)
+        i2c_stats.latency_max = latency;
+
+    return (error == MPU6050_I2C_OK);
+}
+
+/**
+ * @brief Single I2C transaction: register address and tx bytes are written, then rx_len bytes are requested.
+ *        Every wait on the bus is bounded by the clock stretch limit set in begin().
+ * @return uint8_t - MPU6050_I2C_OK or error code.
+ */
+uint8_t MPU6050::transfer(uint8_t reg, const uint8_t *tx, uint8_t tx_len, uint8_t rx_len)
+{
+    uint8_t status;
 
     Wire.beginTransmission(MPU6050_DEFAULT_ADRESS);
+    if (!Wire.write(reg) || (Wire.write(tx, tx_len) != tx_len))
+    {
+        Wire.endTransmission();
+        return MPU6050_I2C_ERROR_DATA_TOO_LONG;
+    }
 
-    if (!Wire.write(reg))
-        return false;
+    /* Repeated start before the read. */
+    status = Wire.endTransmission(rx_len == 0);
+    if (status != 0)
+        return status;
 
-    Wire.write((uint8_t)(value >> 8));
-    Wire.write((uint8_t)(value));
+    if (rx_len == 0)
+        return MPU6050_I2C_OK;
 
-    Wire.endTransmission();
-    return true;
-}
\ No newline at end of file
+    if (Wire.requestFrom((uint8_t)MPU6050_DEFAULT_ADRESS, rx_len) != rx_len)
+    {
+        /* Drop the bytes of a partial read. */
+        while (Wire.available())
+            Wire.read();
+
+        return MPU6050_I2C_ERROR_READ;
+    }
+
+    return MPU6050_I2C_OK;
+}
+
+/**
+ * @brief Releases the bus held by the sensor in the middle of a transfer. SCL is clocked until SDA is released
+ *        and the bus is reinitialized, which generates a STOP condition.
+ */
+void MPU6050::recover_bus(void)
+{
+    i2c_stats.recoveries++;
+    Wire.status();
+    Wire.begin(pin_sda, pin_scl);
+    Wire.setClockStretchLimit(MPU6050_I2C_CLOCK_STRETCH_LIMIT);
+}
+
+bool MPU6050::write_register_word(uint8_t reg, uint16_t value)
+{
+    uint8_t buffer[2] = {(uint8_t)(value >> 8), (uint8_t)value};
+
+    if (!reg)
+        return false;
+
+    return write_registers(reg, buffer, sizeof(buffer));
+}
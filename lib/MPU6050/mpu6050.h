@@ -74,12 +74,14 @@
 #define MPU6050_GYRO_CONFIG_FS_SEL_BITMASK    (0b11100111)
 
 /**  Trigger accelerometer self test and configure the accelerometer full scale range. */
-#define MPU6050_REGISTER_ACCEL_CONFIG         (0x1C)     /* [7] XA_ST, [6] YA_ST, [5] ZA_ST, [4:3] AFS_SEL */
+#define MPU6050_REGISTER_ACCEL_CONFIG         (0x1C)     /* [7] XA_ST, [6] YA_ST, [5] ZA_ST, [4:3] AFS_SEL, [2:0] ACCEL_HPF */
 #define MPU6050_ACCEL_CONFIG_XA_ST            (7)
 #define MPU6050_ACCEL_CONFIG_YA_ST            (6)
 #define MPU6050_ACCEL_CONFIG_ZA_ST            (5)
 #define MPU6050_ACCEL_CONFIG_AFS_SEL_POSITION (3)
 #define MPU6050_ACCEL_CONFIG_AFS_SEL_BITMASK  (0b11100111)
+#define MPU6050_ACCEL_CONFIG_HPF_POSITION     (0)
+#define MPU6050_ACCEL_CONFIG_HPF_BITMASK      (0b11111000)
 
 #define MPU6050_REGISTER_FF_THRESHOLD         (0x1D)
 #define MPU6050_REGISTER_FF_DURATION          (0x1E)
@@ -136,13 +138,15 @@
 #define MPU6050_INT_PIN_CFG_I2C_BYPASS_EN     (1)
 
 /** Enables interrupt generation by interrupt sources. */
-#define MPU6050_REGISTER_INT_ENABLE           (0x38)     /* [4] FIFO_OFLOW_EN, [3] I2C_MST_INT_EN, [0] DATA_RDY_EN */
+#define MPU6050_REGISTER_INT_ENABLE           (0x38)     /* [6] MOT_EN, [4] FIFO_OFLOW_EN, [3] I2C_MST_INT_EN, [0] DATA_RDY_EN */
+#define MPU6050_INT_ENABLE_MOT_EN             (6)
 #define MPU6050_INT_ENABLE_FIFO_OFLOW_EN      (4)
 #define MPU6050_INT_ENABLE_I2C_MST_INT_EN     (3)
 #define MPU6050_INT_ENABLE_DATA_RDY_EN        (0)
 
 /** Shows the interrupt status of each interrupt generation source. */
-#define MPU6050_REGISTER_INT_STATUS           (0x3A)     /* [4] FIFO_OFLOW_INT, [3] I2C_MST_INT_INT, [0] DATA_RDY_INT */
+#define MPU6050_REGISTER_INT_STATUS           (0x3A)     /* [6] MOT_INT, [4] FIFO_OFLOW_INT, [3] I2C_MST_INT_INT, [0] DATA_RDY_INT */
+#define MPU6050_INT_STATUS_MOT_INT            (6)
 #define MPU6050_INT_STATUS_FIFO_OFLOW_INT     (4)
 #define MPU6050_INT_STATUS_I2C_MST_INT_INT    (3)
 #define MPU6050_INT_STATUS_DATA_RDY_INT       (0)
@@ -298,6 +302,17 @@ enum mpu6050_accel_config_afs_sel
     MPU6050_AFS_SEL_16G
 };
 
+/** @brief ACCEL_HPF configures the high pass filter of the data used by the motion detection. */
+enum mpu6050_accel_config_accel_hpf
+{
+    MPU6050_ACCEL_HPF_RESET,    /**< Filter output settles to zero. */
+    MPU6050_ACCEL_HPF_5HZ,      /**< Cut-off frequency 5 Hz. */
+    MPU6050_ACCEL_HPF_2_5HZ,    /**< Cut-off frequency 2.5 Hz. */
+    MPU6050_ACCEL_HPF_1_25HZ,   /**< Cut-off frequency 1.25 Hz. */
+    MPU6050_ACCEL_HPF_0_63HZ,   /**< Cut-off frequency 0.63 Hz. */
+    MPU6050_ACCEL_HPF_HOLD = 7  /**< Filter output is the difference to the sample taken when set. */
+};
+
 /** @brief I2C_MST_CLK configures a I2C master clock speed divider. */
 enum mpu6050_i2c_mst_ctrl_mst_clk
 {
@@ -368,15 +383,84 @@ struct vector
 #define MPU6050_DEFAULT_GYRO_SCALE      MPU6050_FS_SEL_250DPS
 #define MPU6050_DEFAULT_ACCEL_RANGE     MPU6050_AFS_SEL_2G
 
+/** @brief Maximum number of bytes received in a single I2C transaction, BUFFER_LENGTH of the Wire library. */
+#define MPU6050_WIRE_BUFFER_LENGTH      128
+
+/** @brief Size of a single accelerometer sample in the FIFO. */
+#define MPU6050_FIFO_ACCEL_SAMPLE_SIZE  6
+
+/** @brief Size of the FIFO buffer, when full the oldest bytes are overwritten. */
+#define MPU6050_FIFO_SIZE               1024
+
+/** @brief Number of register addresses covered by the shadow copy. */
+#define MPU6050_SHADOW_SIZE             128
+
+/** @brief Maximum time in us the sensor may stretch the I2C clock, bounds every wait on the bus. */
+#define MPU6050_I2C_CLOCK_STRETCH_LIMIT 1500
+
+/** @brief Maximum number of attempts of a single register transaction. */
+#define MPU6050_I2C_ATTEMPTS_MAX        3
+
+/** @brief Maximum number of retries of all transactions, a failing sensor cannot stall the whole wake. */
+#define MPU6050_I2C_RETRY_BUDGET        8
+
+/* I2C transaction error codes, 1 to 4 are the error codes of Wire.endTransmission(). */
+#define MPU6050_I2C_OK                  0
+#define MPU6050_I2C_ERROR_DATA_TOO_LONG 1
+#define MPU6050_I2C_ERROR_NACK_ADDRESS  2
+#define MPU6050_I2C_ERROR_NACK_DATA     3
+#define MPU6050_I2C_ERROR_BUS           4
+#define MPU6050_I2C_ERROR_READ          5
+
 /* Error codes. */
 #define MPU6050_REGISTER_READ_ERROR           (-1)
 #define MPU6050_VECTOR_READ_ERROR             (vector){0, 0, 0}
 //--------------------------------------------------------------------------------
 
+/** @brief I2C transaction counters. */
+struct mpu6050_i2c_stats
+{
+    uint32_t transactions;      /**< Number of transactions, retries included in a single transaction. */
+    uint32_t errors;            /**< Number of failed attempts. */
+    uint32_t retries;           /**< Number of retried attempts. */
+    uint32_t recoveries;        /**< Number of bus recoveries. */
+    uint32_t latency_total;     /**< Sum of the transaction times in us. */
+    uint32_t latency_max;       /**< Longest transaction time in us. */
+    uint8_t last_error;         /**< Error code of the last failed attempt. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief MPU6050 driver.
+ * @note  Configuration registers (SMPLRT_DIV, CONFIG, GYRO_CONFIG, ACCEL_CONFIG, MOT_THR, MOT_DUR, FIFO_EN,
+ *        INT_PIN_CFG, INT_ENABLE, MOT_DETECT_CTRL, USER_CTRL, PWR_MGMT_1, PWR_MGMT_2) are kept in a shadow copy.
+ *        Their setters only change the shadow, the changes are written to the sensor by commit().
+ */
 class MPU6050
 {
 public:
 
+    /**
+     * @brief Initializes the I2C bus, a bus held by the sensor is recovered.
+     * @param [in] pin_sda - SDA pin
+     * @param [in] pin_scl - SCL pin
+     * @return uint8_t - I2C_OK if successful, otherwise the bus status.
+     */
+    uint8_t begin(uint8_t pin_sda, uint8_t pin_scl);
+
+    /**
+     * @brief Returns I2C transaction counters since begin().
+     */
+    const mpu6050_i2c_stats &get_i2c_stats(void);
+
+    /**
+     * @brief Writes the changed configuration registers to the sensor, each register once.
+     *        Adjacent changed registers are written in a single transaction.
+     * @return true if successful, otherwise false.
+     */
+    bool commit(void);
+
     //------------------------------------------------------------------------
     /* SMPRT_DIV (0X19) register. */
 
@@ -497,7 +581,20 @@ public:
      * @brief Get the full scale range of the accelerometer outputs
      * @return @see mpu6050_accel_config_afs_sel 
      */
-    mpu6050_accel_config_afs_sel get_accel_range(void);                         /* TODO : add DHPF configuration*/
+    mpu6050_accel_config_afs_sel get_accel_range(void);
+
+    /**
+     * @brief Set the high pass filter of the accelerometer data used by the motion detection.
+     * @note  The filter does not affect the data in the accelerometer measurement registers.
+     * @param [in] accel_hpf - @see mpu6050_accel_config_accel_hpf
+     */
+    void set_accel_hpf(mpu6050_accel_config_accel_hpf accel_hpf);
+
+    /**
+     * @brief Get the high pass filter configuration of the motion detection.
+     * @return @see mpu6050_accel_config_accel_hpf
+     */
+    mpu6050_accel_config_accel_hpf get_accel_hpf(void);
 
     /**
      * @brief Setting this bit causes the X axis accelerometer to perform self test.
@@ -537,6 +634,38 @@ public:
 
     //------------------------------------------------------------------------
 
+    /**
+     * MOT_THR (0x1F) and MOT_DUR (0x20) registers
+     * Motion is detected when the high pass filtered acceleration of any axis exceeds
+     * the threshold for the duration.
+     */
+
+    /**
+     * @brief Set the motion detection threshold.
+     * @param [in] threshold - threshold in units of 2 mg
+     */
+    void set_mot_threshold(uint8_t threshold);
+
+    /**
+     * @brief Get the motion detection threshold.
+     * @return uint8_t - threshold in units of 2 mg
+     */
+    uint8_t get_mot_threshold(void);
+
+    /**
+     * @brief Set the motion detection duration.
+     * @param [in] duration - number of consecutive samples above the threshold
+     */
+    void set_mot_duration(uint8_t duration);
+
+    /**
+     * @brief Get the motion detection duration.
+     * @return uint8_t - number of consecutive samples above the threshold
+     */
+    uint8_t get_mot_duration(void);
+
+    //------------------------------------------------------------------------
+
     /**
      * FIFO_EN (0x23) register 
      * This register determines which sensor measurements are loaded into the FIFO buffer.
@@ -797,6 +926,18 @@ public:
      */
     bool get_int_enable_i2c_mst(void);
 
+    /**
+     * @brief When set to 1, this bit enables the Motion Detection interrupt.
+     * @param [in] state - Logical state of the bit being set.
+     */
+    void set_int_enable_mot(bool state);
+
+    /**
+     * @brief Get the Motion Detection interrupt bit state.
+     * @return true if set, otherwise false.
+     */
+    bool get_int_enable_mot(void);
+
     /**
      * @brief When set to 1, this bit enables the Data Ready interrupt,
      *        which occurs each time a write operation to all of the sensor registers has been completed.
@@ -839,6 +980,13 @@ public:
      */
     bool get_int_status_fifo_oflow(void);
 
+    /**
+     * @brief  This bit automatically sets to 1 when a Motion Detection interrupt has been generated,
+     *         clears to 0 after the register has been read.
+     * @return Motion Detection interrupt status.
+     */
+    bool get_int_status_mot(void);
+
     //------------------------------------------------------------------------
 
     /**
@@ -1193,6 +1341,22 @@ public:
      */
     uint8_t fifo_read(void);
 
+    /**
+     * @brief Read FIFO buffer in bursts, each I2C transaction reads up to MPU6050_WIRE_BUFFER_LENGTH bytes.
+     * @param [out] buffer - buffer for the data transferred from the FIFO buffer
+     * @param [in] len - number of bytes to read
+     * @return size_t - number of bytes read
+     */
+    size_t fifo_read_burst(uint8_t *buffer, size_t len);
+
+    /**
+     * @brief Read accelerometer samples from the FIFO buffer, only ACCEL_FIFO_EN must be set.
+     * @param [out] samples - buffer for the samples
+     * @param [in] max - size of the buffer
+     * @return size_t - number of samples read
+     */
+    size_t read_accel_samples(vector *samples, size_t max);
+
     //------------------------------------------------------------------------
     
     /**
@@ -1221,6 +1385,23 @@ private:
     bool read_register_bit(uint8_t reg, uint8_t position, bool *state);
     bool read_register_word(uint8_t reg, uint16_t *value);
     bool write_register_word(uint8_t reg, uint16_t value);
+    size_t read_fifo_chunk(uint8_t len);
+    bool read_registers(uint8_t reg, uint8_t *buffer, uint8_t len);
+    bool write_registers(uint8_t reg, const uint8_t *buffer, uint8_t len);
+    bool is_shadowed(uint8_t reg);
+    bool shadow_read(uint8_t reg, uint8_t *value);
+    void shadow_write(uint8_t reg, uint8_t value);
+    bool execute(uint8_t reg, const uint8_t *tx, uint8_t tx_len, uint8_t rx_len, uint8_t attempts);
+    uint8_t transfer(uint8_t reg, const uint8_t *tx, uint8_t tx_len, uint8_t rx_len);
+    void recover_bus(void);
+
+    uint8_t pin_sda = SDA;                              /**< I2C SDA pin. */
+    uint8_t pin_scl = SCL;                              /**< I2C SCL pin. */
+    mpu6050_i2c_stats i2c_stats = {};                   /**< I2C transaction counters. */
+
+    uint8_t shadow[MPU6050_SHADOW_SIZE];                /**< Copy of the configuration registers. */
+    uint32_t shadow_valid[MPU6050_SHADOW_SIZE / 32] = {}; /**< Bit set for registers read from the sensor. */
+    uint32_t shadow_dirty[MPU6050_SHADOW_SIZE / 32] = {}; /**< Bit set for registers waiting for commit(). */
 };
 
 //--------------------------------------------------------------------------------
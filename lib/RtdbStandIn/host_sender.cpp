@@ -0,0 +1,211 @@
+/**
+ * @file host_sender.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "host_sender.h"
+
+//--------------------------------------------------------------------------------
+/* Private variables and types. */
+
+/** @brief JSON object writer with the add() of FirebaseJson used by sender_batch_add(). */
+class HostJson
+{
+public:
+
+    void add(const char *path, float value)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%g", value);
+        append(path, buf);
+    }
+
+    void add(const char *path, int value)
+    {
+        append(path, std::to_string(value).c_str());
+    }
+
+    std::string str() const
+    {
+        return "{" + body + "}";
+    }
+
+private:
+
+    void append(const char *path, const char *value)
+    {
+        if (!body.empty())
+            body += ",";
+
+        body += "\"";
+        body += path;
+        body += "\":";
+        body += value;
+    }
+
+    std::string body;
+};
+
+//--------------------------------------------------------------------------------
+
+HostSender::HostSender(RtdbStandIn &database, const std::string &email, uint32_t device_id, size_t records_max)
+    : database(database), email(email)
+{
+    this->device_id = device_id;
+    this->records_max = records_max;
+    this->token_expires = 0;
+    this->time = 0;
+    this->connected = false;
+    this->stats = host_sender_stats();
+}
+
+bool HostSender::send_data(uint64_t time, std::deque<data> &backlog, const data *measurement)
+{
+    std::vector<data> records(this->records_max);
+    upload_link link = {this, &backlog, time};
+    uint32_t sent;
+
+    /* Every wake-up opens a new connection. */
+    this->time = time;
+    this->connected = false;
+    this->stats.wakes++;
+
+    bool measurement_sent = sender_upload(link, records.data(), this->records_max, measurement, &sent);
+
+    this->stats.records += sent;
+    this->stats.radio_time += this->time - time;
+    return measurement_sent;
+}
+
+uint64_t HostSender::get_time() const
+{
+    return this->time;
+}
+
+const std::string &HostSender::get_uid() const
+{
+    return this->uid;
+}
+
+const host_sender_stats &HostSender::get_stats() const
+{
+    return this->stats;
+}
+
+bool HostSender::ready()
+{
+    if (!this->token.empty() && (sender_token_remaining(this->time / 1000000, this->token_expires) > 0))
+        return true;
+
+    /* The auth endpoints are on another host, each exchange opens its own connection. */
+    rtdb_answer answer;
+    if (this->refresh_token.empty())
+        answer = this->database.sign_in(this->time, false, this->email, &this->token, &this->refresh_token, &this->uid);
+    else
+        answer = this->database.refresh(this->time, false, this->refresh_token, &this->token);
+
+    account(answer);
+
+    if (answer.status == RTDB_STATUS_OK)
+    {
+        this->token_expires = this->time / 1000000 + SENDER_TOKEN_LIFETIME;
+        this->database_path = "UsersData/" + this->uid + "/readings";
+        return true;
+    }
+
+    if (sender_token_rejected(answer.status))
+    {
+        this->token.clear();
+        this->refresh_token.clear();
+    }
+
+    return false;
+}
+
+bool HostSender::send_batch(const data *records, size_t count)
+{
+    HostJson json;
+
+    if (!ready())
+        return false;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        char key[SENDER_KEY_BUF_SIZE];
+
+        sender_record_key(records[i], this->device_id, records[i].time != HOST_SENDER_TIME_ERROR, key);
+        sender_batch_add(json, key, records[i], records[i].time != HOST_SENDER_TIME_ERROR);
+    }
+
+    rtdb_answer answer = this->database.update(this->time, this->connected, this->token, this->database_path, json.str());
+    account(answer);
+
+    /* A lost request closes the connection, the next one pays for the handshake again. */
+    this->connected = (answer.status != RTDB_STATUS_TIMEOUT);
+
+    if (answer.status == RTDB_STATUS_NO_CONTENT)
+    {
+        this->stats.batches++;
+        return true;
+    }
+
+    /* The database did not accept the token, it is refreshed before the next attempt. */
+    if (answer.status == RTDB_STATUS_UNAUTHORIZED)
+        this->token_expires = 0;
+
+    return false;
+}
+
+uint32_t HostSender::upload_link::count()
+{
+    return this->backlog->size();
+}
+
+size_t HostSender::upload_link::read(data *records, size_t max)
+{
+    size_t count = std::min(this->backlog->size(), max);
+
+    std::copy(this->backlog->begin(), this->backlog->begin() + count, records);
+    return count;
+}
+
+void HostSender::upload_link::drop(size_t count)
+{
+    this->backlog->erase(this->backlog->begin(), this->backlog->begin() + count);
+}
+
+void HostSender::upload_link::save(const data &measurement)
+{
+    this->backlog->push_back(measurement);
+}
+
+bool HostSender::upload_link::send(const data *records, size_t count)
+{
+    return this->sender->send_batch(records, count);
+}
+
+uint32_t HostSender::upload_link::elapsed()
+{
+    return (this->sender->time - this->start) / 1000;
+}
+
+void HostSender::upload_link::retry(int attempt)
+{
+    (void)attempt;
+    this->sender->stats.retries++;
+}
+
+void HostSender::account(const rtdb_answer &answer)
+{
+    this->stats.requests++;
+    this->stats.sent += answer.sent;
+    this->stats.received += answer.received;
+    this->time = answer.time;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file host_sender.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef HOST_SENDER_H_
+#define HOST_SENDER_H_
+
+//--------------------------------------------------------------------------------
+
+#include <deque>
+#include <string>
+#include <sender_protocol.h>
+#include "rtdb_stand_in.h"
+
+//--------------------------------------------------------------------------------
+
+/** @brief Time of a measurement without time, TIME_ERROR of the firmware. */
+#define HOST_SENDER_TIME_ERROR  0
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Counters of the uploads of a HostSender. */
+struct host_sender_stats
+{
+    uint32_t wakes;             /**< Online wake-ups. */
+    uint32_t requests;          /**< Requests, including the auth ones. */
+    uint32_t batches;           /**< Acknowledged batches. */
+    uint32_t retries;           /**< Repeated attempts to send a batch. */
+    uint32_t records;           /**< Acknowledged measurements. */
+    uint64_t sent;              /**< Bytes sent. */
+    uint64_t received;          /**< Bytes received. */
+    uint64_t radio_time;        /**< Time spent uploading, in us. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Host build of the upload path of Sender, talking to RtdbStandIn instead of Firebase.
+ *        The upload runs sender_upload() of the firmware with chunks of SENDER_BATCH_RECORDS_MAX,
+ *        or of another batch size under evaluation. Batches are built with sender_batch_add() and keyed
+ *        with sender_record_key(), the token is refreshed and dropped after sender_token_remaining()
+ *        and sender_token_rejected(). Only the transport and the token storage are host code,
+ *        the auth token is kept between wake-ups like the token file of Sender.
+ */
+class HostSender
+{
+public:
+
+    /**
+     * @brief Construct a new Host Sender object.
+     * @param [in] database - stand-in the measurements are sent to
+     * @param [in] email - email of the user
+     * @param [in] device_id - ID of the device in the keys of its measurements, the chip ID on the device
+     * @param [in] records_max - maximum number of measurements in a single update
+     */
+    HostSender(RtdbStandIn &database, const std::string &email, uint32_t device_id,
+               size_t records_max = SENDER_BATCH_RECORDS_MAX);
+
+    /**
+     * @brief Sends the measurement and the backlog in one online wake-up.
+     * @param [in] time - time of the wake-up since epoch, in us
+     * @param [in,out] backlog - saved measurements, the acknowledged ones are removed, an unsent measurement is appended
+     * @param [in] measurement - current measurement, nullptr sends only the backlog
+     * @return true if the measurement and the backlog were sent, false if the rest was left for the next wake-up
+     */
+    bool send_data(uint64_t time, std::deque<data> &backlog, const data *measurement);
+
+    /**
+     * @brief Get the time the last wake-up finished uploading.
+     * @return uint64_t - time since epoch, in us
+     */
+    uint64_t get_time() const;
+
+    /**
+     * @brief Get the user ID of the signed in user.
+     * @return const std::string& - user ID, empty before the first sign-in
+     */
+    const std::string &get_uid() const;
+
+    /**
+     * @brief Get the counters of the uploads.
+     * @return const host_sender_stats& - counters
+     */
+    const host_sender_stats &get_stats() const;
+
+private:
+
+    /** @brief Backlog and stand-in of the sender, as used by sender_upload(). */
+    struct upload_link
+    {
+        HostSender *sender;         /**< Sender of the upload. */
+        std::deque<data> *backlog;  /**< Saved measurements. */
+        uint64_t start;             /**< Time the upload started, in us. */
+
+        /** @brief Number of measurements in the backlog. */
+        uint32_t count();
+
+        /** @brief Copies the oldest measurements of the backlog. */
+        size_t read(data *records, size_t max);
+
+        /** @brief Removes the acknowledged measurements from the backlog. */
+        void drop(size_t count);
+
+        /** @brief Appends the unsent measurement to the backlog. */
+        void save(const data &measurement);
+
+        /** @brief Sends a chunk, @see send_batch(). */
+        bool send(const data *records, size_t count);
+
+        /** @brief Time since the upload started, in ms. */
+        uint32_t elapsed();
+
+        /** @brief Counts the next attempt of a chunk. */
+        void retry(int attempt);
+    };
+
+    /**
+     * @brief Signs in or refreshes the token when it is missing or close to expiry, like Firebase.ready().
+     * @return true if a valid token is available, otherwise false
+     */
+    bool ready();
+
+    /**
+     * @brief Sends a chunk of measurements in a single multi-path update.
+     * @param [in] records - Pointer to the first measurement of the chunk
+     * @param [in] count - Number of measurements in the chunk
+     * @return true if the update was acknowledged by the database, otherwise false
+     */
+    bool send_batch(const data *records, size_t count);
+
+    /** @brief Adds the request to the counters and moves the time to its answer. */
+    void account(const rtdb_answer &answer);
+
+    RtdbStandIn &database;      /**< Stand-in the measurements are sent to. */
+    std::string email;          /**< Email of the user. */
+    std::string token;          /**< ID token, empty if there is none. */
+    std::string refresh_token;  /**< Refresh token, empty before the sign-in. */
+    std::string uid;            /**< User ID. */
+    std::string database_path;  /**< Path of the readings. */
+    uint32_t device_id;         /**< ID of the device in the keys of its measurements. */
+    size_t records_max;         /**< Maximum number of measurements in a single update. */
+    uint32_t token_expires;     /**< Expiry time of the ID token since epoch, in seconds. */
+    uint64_t time;              /**< Current time, in us. */
+    bool connected;             /**< Flag indicating the keep-alive connection to the database is open. */
+    host_sender_stats stats;    /**< Counters of the uploads. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* HOST_SENDER_H_ */
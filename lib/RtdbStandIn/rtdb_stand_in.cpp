@@ -0,0 +1,439 @@
+/**
+ * @file rtdb_stand_in.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <set>
+#include "rtdb_stand_in.h"
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static bool parse_update(const std::string &body, std::vector<std::pair<std::string, std::string>> *fields);
+static bool is_valid_path(const std::string &path);
+static bool is_value(const std::string &value);
+static uint64_t find_gap(const std::map<uint64_t, uint64_t> &busy, uint64_t time, uint64_t length);
+
+//--------------------------------------------------------------------------------
+
+RtdbStandIn::RtdbStandIn(const rtdb_stand_in_config &config, uint32_t seed)
+{
+    this->config = config;
+    this->stats = rtdb_stand_in_stats();
+    this->seed = (seed != 0) ? seed : 1;
+    this->token_count = 0;
+    this->round_trip = 0;
+    this->request_time = 0;
+    this->workers.resize(std::max<uint32_t>(config.workers, 1));
+}
+
+rtdb_answer RtdbStandIn::sign_in(uint64_t time, bool connected, const std::string &email,
+                                 std::string *token, std::string *refresh_token, std::string *uid)
+{
+    rtdb_answer answer;
+    uint64_t arrival;
+
+    if (!send(time, connected, RTDB_REQUEST_HEADER_SIZE + email.size() + 80, &answer, &arrival))
+        return answer;
+
+    this->stats.sign_ins++;
+    *uid = "u" + std::to_string(std::hash<std::string>()(email) % 1000000000);
+    *token = issue_token(*uid, arrival);
+    *refresh_token = "r" + std::to_string(this->token_count);
+    refresh_token->resize(RTDB_REFRESH_TOKEN_SIZE, '0');
+    this->refresh_uids[*refresh_token] = *uid;
+
+    reply(arrival, this->config.auth_service, RTDB_STATUS_OK, RTDB_ANSWER_HEADER_SIZE + RTDB_TOKEN_SIZE + RTDB_REFRESH_TOKEN_SIZE + 200, &answer);
+    return answer;
+}
+
+rtdb_answer RtdbStandIn::refresh(uint64_t time, bool connected, const std::string &refresh_token, std::string *token)
+{
+    rtdb_answer answer;
+    uint64_t arrival;
+
+    if (!send(time, connected, RTDB_REQUEST_HEADER_SIZE + refresh_token.size() + 60, &answer, &arrival))
+        return answer;
+
+    auto uid = this->refresh_uids.find(refresh_token);
+    if (uid == this->refresh_uids.end())
+    {
+        this->stats.unauthorized++;
+        reply(arrival, 0, RTDB_STATUS_BAD_REQUEST, RTDB_ANSWER_HEADER_SIZE + 100, &answer);
+        return answer;
+    }
+
+    this->stats.refreshes++;
+    *token = issue_token(uid->second, arrival);
+
+    reply(arrival, this->config.auth_service, RTDB_STATUS_OK, RTDB_ANSWER_HEADER_SIZE + RTDB_TOKEN_SIZE + RTDB_REFRESH_TOKEN_SIZE + 250, &answer);
+    return answer;
+}
+
+rtdb_answer RtdbStandIn::update(uint64_t time, bool connected, const std::string &token, const std::string &path, const std::string &body)
+{
+    rtdb_answer answer;
+    uint64_t arrival;
+    std::vector<std::pair<std::string, std::string>> fields;
+
+    /* PATCH /<path>.json?auth=<token>&print=silent */
+    if (!send(time, connected, RTDB_REQUEST_HEADER_SIZE + path.size() + token.size() + 30 + body.size(), &answer, &arrival))
+        return answer;
+
+    if (this->config.rate_limit > 0)
+    {
+        uint32_t &window = this->windows[arrival / 1000000];
+
+        if (window >= this->config.rate_limit)
+        {
+            this->stats.rejected++;
+            reply(arrival, 0, RTDB_STATUS_TOO_MANY, RTDB_ANSWER_HEADER_SIZE + 60, &answer);
+            return answer;
+        }
+
+        window++;
+    }
+
+    /* Security rules of the project, a user writes only below its own node. */
+    auto uid = this->token_uids.find(token);
+    std::string root = (uid != this->token_uids.end()) ? "UsersData/" + uid->second : "";
+    if (!is_authorized(token, arrival) || (path.compare(0, root.size(), root) != 0) ||
+        ((path.size() > root.size()) && (path[root.size()] != '/')))
+    {
+        this->stats.unauthorized++;
+        reply(arrival, 0, RTDB_STATUS_UNAUTHORIZED, RTDB_ANSWER_HEADER_SIZE + 60, &answer);
+        return answer;
+    }
+
+    if (!is_valid_path(path) || !parse_update(body, &fields))
+    {
+        this->stats.malformed++;
+        reply(arrival, 0, RTDB_STATUS_BAD_REQUEST, RTDB_ANSWER_HEADER_SIZE + 80, &answer);
+        return answer;
+    }
+
+    for (auto &field : fields)
+        write(path + "/" + field.first, field.second);
+
+    this->stats.updates++;
+    this->stats.values += fields.size();
+    this->stats.load[arrival / 1000000]++;
+
+    /* The update is applied, but its answer does not reach the client. */
+    if ((this->config.reply_loss_rate > 0) && (random_unit() < this->config.reply_loss_rate))
+    {
+        process(arrival, this->config.service * fields.size());
+        this->stats.failed++;
+        this->stats.lost_replies++;
+        answer.status = RTDB_STATUS_TIMEOUT;
+        answer.time = time + this->config.timeout;
+        return answer;
+    }
+
+    reply(arrival, this->config.service * fields.size(), RTDB_STATUS_NO_CONTENT, RTDB_ANSWER_HEADER_SIZE, &answer);
+    return answer;
+}
+
+size_t RtdbStandIn::count(const std::string &path) const
+{
+    return children(path).size();
+}
+
+std::vector<std::string> RtdbStandIn::children(const std::string &path) const
+{
+    std::string prefix = path + "/";
+    std::vector<std::string> keys;
+
+    /* Paths with a common prefix are adjacent in the map, the leaves of a child are listed once. */
+    for (auto it = this->values.lower_bound(prefix); (it != this->values.end()) && (it->first.compare(0, prefix.size(), prefix) == 0); it++)
+    {
+        std::string child = it->first.substr(prefix.size(), it->first.find('/', prefix.size()) - prefix.size());
+
+        if (keys.empty() || (child != keys.back()))
+            keys.push_back(child);
+    }
+
+    return keys;
+}
+
+const std::string *RtdbStandIn::get(const std::string &path) const
+{
+    auto it = this->values.find(path);
+    return (it != this->values.end()) ? &it->second : nullptr;
+}
+
+const rtdb_stand_in_stats &RtdbStandIn::get_stats() const
+{
+    return this->stats;
+}
+
+bool RtdbStandIn::send(uint64_t time, bool connected, uint32_t size, rtdb_answer *answer, uint64_t *arrival)
+{
+    this->stats.requests++;
+    this->request_time = time;
+    this->round_trip = this->config.latency + ((this->config.jitter > 0) ? random_next() % (this->config.jitter + 1) : 0);
+
+    answer->status = RTDB_STATUS_OK;
+    answer->sent = size;
+    answer->received = 0;
+    *arrival = time + this->round_trip / 2 + (uint64_t)size * 1000000 / this->config.bandwidth;
+
+    /* TLS 1.2 handshake, two round trips and the key exchange. */
+    if (!connected)
+    {
+        this->stats.handshakes++;
+        answer->received += RTDB_HANDSHAKE_SIZE;
+        *arrival += 2 * this->round_trip + this->config.handshake + (uint64_t)RTDB_HANDSHAKE_SIZE * 1000000 / this->config.bandwidth;
+    }
+
+    if (random_unit() < this->config.loss_rate)
+    {
+        this->stats.failed++;
+        answer->status = RTDB_STATUS_TIMEOUT;
+        answer->time = time + this->config.timeout;
+        return false;
+    }
+
+    if (random_unit() < this->config.error_rate)
+    {
+        this->stats.failed++;
+        reply(*arrival, 0, RTDB_STATUS_UNAVAILABLE, RTDB_ANSWER_HEADER_SIZE + 60, answer);
+        return false;
+    }
+
+    return true;
+}
+
+uint64_t RtdbStandIn::process(uint64_t arrival, uint32_t service)
+{
+    std::map<uint64_t, uint64_t> *worker = nullptr;
+    uint64_t start = UINT64_MAX;
+
+    if (service == 0)
+        return arrival;
+
+    /* The request waits for the worker which can process it first. */
+    for (auto &busy : this->workers)
+    {
+        uint64_t gap = find_gap(busy, arrival, service);
+        if (gap < start)
+        {
+            start = gap;
+            worker = &busy;
+        }
+    }
+
+    (*worker)[start] = start + service;
+    return start + service;
+}
+
+void RtdbStandIn::reply(uint64_t arrival, uint32_t service, int status, uint32_t size, rtdb_answer *answer)
+{
+    uint64_t done = process(arrival, service);
+
+    answer->status = status;
+    answer->received += size;
+    answer->time = done + this->round_trip / 2 + (uint64_t)size * 1000000 / this->config.bandwidth;
+
+    this->stats.latency += answer->time - this->request_time;
+    this->stats.latencies.push_back(answer->time - this->request_time);
+}
+
+void RtdbStandIn::write(const std::string &path, const std::string &value)
+{
+    /* The value replaces the whole subtree of the path. */
+    std::string prefix = path + "/";
+    auto it = this->values.lower_bound(prefix);
+    while ((it != this->values.end()) && (it->first.compare(0, prefix.size(), prefix) == 0))
+        it = this->values.erase(it);
+
+    /* Leaves on the way become nodes. */
+    for (size_t i = path.find('/'); i != std::string::npos; i = path.find('/', i + 1))
+        this->values.erase(path.substr(0, i));
+
+    std::string &stored = this->values[path];
+    this->stats.rewrites += (stored == value);
+    stored = value;
+}
+
+bool RtdbStandIn::is_authorized(const std::string &token, uint64_t time) const
+{
+    auto it = this->tokens.find(token);
+    return (it != this->tokens.end()) && (time < it->second);
+}
+
+std::string RtdbStandIn::issue_token(const std::string &uid, uint64_t time)
+{
+    std::string token = "t" + std::to_string(++this->token_count) + ".";
+
+    token.resize(RTDB_TOKEN_SIZE, '0');
+    this->tokens[token] = time + (uint64_t)this->config.token_lifetime * 1000000;
+    this->token_uids[token] = uid;
+    return token;
+}
+
+uint32_t RtdbStandIn::random_next()
+{
+    this->seed ^= this->seed << 13;
+    this->seed ^= this->seed >> 17;
+    this->seed ^= this->seed << 5;
+    return this->seed;
+}
+
+float RtdbStandIn::random_unit()
+{
+    return (random_next() >> 8) / 16777216.0f;
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Parses the body of a multi-path update, a flat JSON object of subpaths and values.
+ *        Subpaths may not be empty, contain characters forbidden in keys or overlap each other.
+ * @param [in] body - JSON object
+ * @param [out] fields - subpaths and their values as written in the JSON
+ * @return true if the body is a valid update, otherwise false
+ */
+static bool parse_update(const std::string &body, std::vector<std::pair<std::string, std::string>> *fields)
+{
+    std::set<std::string> paths;
+    size_t i = 0;
+
+    auto skip_spaces = [&]() { while ((i < body.size()) && isspace((unsigned char)body[i])) i++; };
+
+    skip_spaces();
+    if ((i >= body.size()) || (body[i++] != '{'))
+        return false;
+
+    skip_spaces();
+    bool empty = (i < body.size()) && (body[i] == '}');
+
+    while (!empty && (i < body.size()))
+    {
+        skip_spaces();
+        if ((i >= body.size()) || (body[i++] != '"'))
+            return false;
+
+        size_t end = body.find('"', i);
+        if (end == std::string::npos)
+            return false;
+
+        std::string path = body.substr(i, end - i);
+        i = end + 1;
+
+        skip_spaces();
+        if ((i >= body.size()) || (body[i++] != ':'))
+            return false;
+
+        skip_spaces();
+        end = i;
+        if ((end < body.size()) && (body[end] == '"'))
+            end = body.find('"', end + 1) + 1;
+        else
+            while ((end < body.size()) && (body[end] != ',') && (body[end] != '}') && !isspace((unsigned char)body[end])) end++;
+
+        if ((end == 0) || (end > body.size()))
+            return false;
+
+        std::string value = body.substr(i, end - i);
+        i = end;
+
+        if (!is_valid_path(path) || !is_value(value) || !paths.insert(path).second)
+            return false;
+
+        fields->emplace_back(path, value);
+
+        skip_spaces();
+        if (i >= body.size())
+            return false;
+
+        if (body[i] == '}')
+            break;
+
+        if (body[i++] != ',')
+            return false;
+    }
+
+    skip_spaces();
+    if ((i >= body.size()) || (body[i++] != '}'))
+        return false;
+
+    skip_spaces();
+    if (i != body.size())
+        return false;
+
+    /* A subpath may not be an ancestor of another one. */
+    for (auto &path : paths)
+    {
+        for (size_t j = path.find('/'); j != std::string::npos; j = path.find('/', j + 1))
+        {
+            if (paths.count(path.substr(0, j)))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks the path, keys may not be empty or contain . $ # [ ]
+ * @param [in] path - path of slash separated keys
+ * @return true if the path is valid, otherwise false
+ */
+static bool is_valid_path(const std::string &path)
+{
+    if (path.empty() || (path.front() == '/') || (path.back() == '/') || (path.find("//") != std::string::npos))
+        return false;
+
+    return path.find_first_of(".$#[]") == std::string::npos;
+}
+
+/**
+ * @brief Checks the value is a JSON number, string, boolean or null.
+ * @param [in] value - value as written in the JSON
+ * @return true if the value is valid, otherwise false
+ */
+static bool is_value(const std::string &value)
+{
+    if (value.empty())
+        return false;
+
+    if ((value == "true") || (value == "false") || (value == "null"))
+        return true;
+
+    if (value.front() == '"')
+        return (value.size() >= 2) && (value.back() == '"');
+
+    char *end;
+    strtod(value.c_str(), &end);
+    return *end == '\0';
+}
+
+/**
+ * @brief Finds the first free gap of the worker.
+ * @param [in] busy - busy intervals of the worker, the end by the start
+ * @param [in] time - earliest start of the gap
+ * @param [in] length - length of the gap
+ * @return uint64_t - start of the gap
+ */
+static uint64_t find_gap(const std::map<uint64_t, uint64_t> &busy, uint64_t time, uint64_t length)
+{
+    auto it = busy.upper_bound(time);
+
+    if ((it != busy.begin()) && (std::prev(it)->second > time))
+        time = std::prev(it)->second;
+
+    for (; (it != busy.end()) && (it->first < time + length); it++)
+        time = std::max(time, it->second);
+
+    return time;
+}
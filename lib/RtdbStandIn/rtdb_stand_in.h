@@ -0,0 +1,253 @@
+/**
+ * @file rtdb_stand_in.h
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#ifndef RTDB_STAND_IN_H_
+#define RTDB_STAND_IN_H_
+
+//--------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <map>
+#include <string>
+#include <vector>
+
+//--------------------------------------------------------------------------------
+
+/* HTTP status codes of the answers. */
+#define RTDB_STATUS_OK              200
+#define RTDB_STATUS_NO_CONTENT      204     /**< Answer to a request with print=silent. */
+#define RTDB_STATUS_BAD_REQUEST     400
+#define RTDB_STATUS_UNAUTHORIZED    401
+#define RTDB_STATUS_TOO_MANY        429
+#define RTDB_STATUS_UNAVAILABLE     503
+
+/** @brief Status of a request without an answer, negative like the connection errors of the client library. */
+#define RTDB_STATUS_TIMEOUT         (-4)
+
+/** @brief Length of an issued ID token, a Firebase ID token is about 900 characters. */
+#define RTDB_TOKEN_SIZE             900
+
+/** @brief Length of an issued refresh token. */
+#define RTDB_REFRESH_TOKEN_SIZE     180
+
+/** @brief Size of the request line and the headers of a request, without the path and the token. */
+#define RTDB_REQUEST_HEADER_SIZE    160
+
+/** @brief Size of the status line and the headers of an answer. */
+#define RTDB_ANSWER_HEADER_SIZE     220
+
+/** @brief Bytes exchanged in a TLS handshake, mostly the certificate chain of the server. */
+#define RTDB_HANDSHAKE_SIZE         5500
+
+//--------------------------------------------------------------------------------
+/* Public constants and types. */
+
+/** @brief Behaviour of the network and the database, times in us. */
+struct rtdb_stand_in_config
+{
+    uint32_t latency;           /**< Round trip time of the network. */
+    uint32_t jitter;            /**< Maximum random addition to the round trip time. */
+    uint32_t handshake;         /**< Time of the TLS handshake of a new connection, on top of its round trips. */
+    uint32_t bandwidth;         /**< Throughput of the link, in bytes per second. */
+    uint32_t service;           /**< Processing time of a single written value. */
+    uint32_t workers;           /**< Number of requests processed in parallel. */
+    uint32_t rate_limit;        /**< Write requests accepted per second, 0 for no limit. */
+    uint32_t auth_service;      /**< Processing time of a sign-in or a token refresh. */
+    uint32_t token_lifetime;    /**< Lifetime of the issued ID tokens, in seconds. */
+    uint32_t timeout;           /**< Time the client waits for an answer which does not come. */
+    float error_rate;           /**< Probability of an answer with RTDB_STATUS_UNAVAILABLE. */
+    float loss_rate;            /**< Probability that a request is lost on the way to the database. */
+    float reply_loss_rate;      /**< Probability that the answer to an applied update is lost, the client retries
+                                     an update the database already holds. */
+};
+
+/** @brief Answer to a request. */
+struct rtdb_answer
+{
+    int status;                 /**< HTTP status code or RTDB_STATUS_TIMEOUT. */
+    uint64_t time;              /**< Time the answer was received by the client, in us. */
+    uint32_t sent;              /**< Bytes sent by the client, including the handshake. */
+    uint32_t received;          /**< Bytes received by the client, including the handshake. */
+};
+
+/** @brief Counters of the requests processed by the stand-in. */
+struct rtdb_stand_in_stats
+{
+    uint32_t requests;          /**< All requests, including the lost ones. */
+    uint32_t updates;           /**< Applied multi-path updates. */
+    uint32_t values;            /**< Written values. */
+    uint32_t sign_ins;          /**< Sign-ins with the email and password. */
+    uint32_t refreshes;         /**< Exchanges of a refresh token. */
+    uint32_t handshakes;        /**< TLS handshakes. */
+    uint32_t rejected;          /**< Requests answered with RTDB_STATUS_TOO_MANY. */
+    uint32_t failed;            /**< Requests answered with RTDB_STATUS_UNAVAILABLE or lost, including lost answers. */
+    uint32_t lost_replies;      /**< Applied updates whose answer was lost. */
+    uint32_t rewrites;          /**< Values written again with the value already stored at their path. */
+    uint32_t unauthorized;      /**< Requests with an expired or unknown token. */
+    uint32_t malformed;         /**< Requests answered with RTDB_STATUS_BAD_REQUEST. */
+    uint64_t latency;           /**< Sum of the times from sending a request to its answer, in us. */
+    std::map<uint64_t, uint32_t> load;  /**< Applied updates in each second since epoch. */
+    std::vector<uint32_t> latencies;    /**< Time of every answered request, in us. */
+};
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief In-process stand-in of the Firebase Realtime Database REST API and the auth endpoints,
+ *        the subset used by Sender. Time is virtual, every request carries the time it is sent
+ *        and gets the time its answer arrives, so runs are reproducible and take no real time.
+ *        Requests may come out of the order of their time, e.g. from devices simulated one wake-up
+ *        at a time: a request takes the first gap of a worker at or after its arrival and the rate
+ *        limit counts the write requests in fixed one-second windows.
+ *
+ *        Modelled endpoints:
+ *        - POST accounts:signInWithPassword, a new ID token and refresh token;
+ *        - POST securetoken token, a new ID token for the refresh token;
+ *        - PATCH <path>.json?auth=<token>&print=silent, a multi-path update (FB_RTDB::updateNodeSilent).
+ *
+ *        The endpoints are modelled as function calls of the client, there is no HTTP or TLS on the host:
+ *        the bytes of the requests, the answers and the handshakes are only counted for their time.
+ */
+class RtdbStandIn
+{
+public:
+
+    /**
+     * @brief Construct a new stand-in with an empty database.
+     * @param [in] config - behaviour of the network and the database
+     * @param [in] seed - seed of the injected latency and failures
+     */
+    RtdbStandIn(const rtdb_stand_in_config &config, uint32_t seed);
+
+    /**
+     * @brief Signs the user in with the email and password.
+     * @param [in] time - time the request is sent, in us
+     * @param [in] connected - false if the request opens a new connection
+     * @param [in] email - email of the user, every email gets its own user ID
+     * @param [out] token - issued ID token
+     * @param [out] refresh_token - issued refresh token
+     * @param [out] uid - user ID
+     * @return rtdb_answer - answer, RTDB_STATUS_OK if the tokens were issued
+     */
+    rtdb_answer sign_in(uint64_t time, bool connected, const std::string &email,
+                        std::string *token, std::string *refresh_token, std::string *uid);
+
+    /**
+     * @brief Exchanges the refresh token for a new ID token.
+     * @param [in] time - time the request is sent, in us
+     * @param [in] connected - false if the request opens a new connection
+     * @param [in] refresh_token - refresh token of a previous sign-in
+     * @param [out] token - issued ID token
+     * @return rtdb_answer - answer, RTDB_STATUS_OK if the token was issued
+     */
+    rtdb_answer refresh(uint64_t time, bool connected, const std::string &refresh_token, std::string *token);
+
+    /**
+     * @brief Applies a multi-path update, all values of the body are written or none of them.
+     * @param [in] time - time the request is sent, in us
+     * @param [in] connected - false if the request opens a new connection
+     * @param [in] token - ID token
+     * @param [in] path - path of the updated node
+     * @param [in] body - JSON object of the subpaths and their values
+     * @return rtdb_answer - answer, RTDB_STATUS_NO_CONTENT if the update was applied,
+     *         RTDB_STATUS_TIMEOUT also for an applied update whose answer was lost
+     */
+    rtdb_answer update(uint64_t time, bool connected, const std::string &token, const std::string &path, const std::string &body);
+
+    /**
+     * @brief Get the number of children of the node.
+     * @param [in] path - path of the node
+     * @return size_t - number of children
+     */
+    size_t count(const std::string &path) const;
+
+    /**
+     * @brief Get the keys of the children of the node.
+     * @param [in] path - path of the node
+     * @return std::vector<std::string> - keys in the order of the database, chronological for push keys
+     */
+    std::vector<std::string> children(const std::string &path) const;
+
+    /**
+     * @brief Get the value stored at the path.
+     * @param [in] path - path of the value
+     * @return const std::string* - value as written in the JSON, nullptr if the path does not exist
+     */
+    const std::string *get(const std::string &path) const;
+
+    /**
+     * @brief Get the counters of the processed requests.
+     * @return const rtdb_stand_in_stats& - counters
+     */
+    const rtdb_stand_in_stats &get_stats() const;
+
+private:
+
+    /**
+     * @brief Sends the request to the database, the network part common to all requests.
+     * @param [in] time - time the request is sent, in us
+     * @param [in] connected - false if the request opens a new connection
+     * @param [in] size - size of the request
+     * @param [out] answer - answer, filled in if the request is lost or fails
+     * @param [out] arrival - time the request arrives at the database, in us
+     * @return true if the request can be processed, false if the answer is final
+     */
+    bool send(uint64_t time, bool connected, uint32_t size, rtdb_answer *answer, uint64_t *arrival);
+
+    /**
+     * @brief Processes the request by the first free worker.
+     * @param [in] arrival - time the request arrived at the database, in us
+     * @param [in] service - processing time of the request, in us, 0 if it does not need a worker
+     * @return uint64_t - time the processing is done, in us
+     */
+    uint64_t process(uint64_t arrival, uint32_t service);
+
+    /**
+     * @brief Processes the request by the first free worker and sends the answer back.
+     * @param [in] arrival - time the request arrived at the database, in us
+     * @param [in] service - processing time of the request, in us, 0 if it does not need a worker
+     * @param [in] status - HTTP status code of the answer
+     * @param [in] size - size of the answer
+     * @param [out] answer - answer
+     */
+    void reply(uint64_t arrival, uint32_t service, int status, uint32_t size, rtdb_answer *answer);
+
+    /** @brief Writes the value at the path, replacing its subtree and the leaves on the way. */
+    void write(const std::string &path, const std::string &value);
+
+    /** @brief Checks whether the ID token was issued and has not expired at the time, in us. */
+    bool is_authorized(const std::string &token, uint64_t time) const;
+
+    /** @brief Issues a new ID token valid from the time, in us. */
+    std::string issue_token(const std::string &uid, uint64_t time);
+
+    /** @brief Deterministic pseudo-random number. */
+    uint32_t random_next();
+
+    /** @brief Pseudo-random number in [0, 1). */
+    float random_unit();
+
+    rtdb_stand_in_config config;                    /**< Behaviour of the network and the database. */
+    rtdb_stand_in_stats stats;                      /**< Counters of the processed requests. */
+    uint32_t seed;                                  /**< State of the pseudo-random generator. */
+    uint32_t token_count;                           /**< Number of issued tokens, makes every token unique. */
+    uint32_t round_trip;                            /**< Round trip time of the current request, in us. */
+    uint64_t request_time;                          /**< Time the current request was sent, in us. */
+    std::map<uint64_t, uint32_t> windows;           /**< Accepted write requests in each second since epoch. */
+    std::vector<std::map<uint64_t, uint64_t>> workers;  /**< Busy intervals of each worker, the end by the start, in us. */
+    std::map<std::string, uint64_t> tokens;         /**< Expiry time of the issued ID tokens, in us. */
+    std::map<std::string, std::string> token_uids;  /**< User ID of the issued ID tokens. */
+    std::map<std::string, std::string> refresh_uids;/**< User ID of the issued refresh tokens. */
+    std::map<std::string, std::string> values;      /**< Database, the values of the leaves by their path. */
+};
+
+//--------------------------------------------------------------------------------
+
+#endif /* RTDB_STAND_IN_H_ */
@@ -7,6 +7,7 @@
 
 //-------------------------------------------------------------------------------- 
 
+#include <algorithm>
 #include <accelgyro_manager.h>
 
 //--------------------------------------------------------------------------------
@@ -20,13 +21,16 @@
 //--------------------------------------------------------------------------------
 
 static bool operator ==(vector a, vector b);
+static float calculate_tilt(const vector &accel);
 
 //--------------------------------------------------------------------------------
 
 void Accelgyro::init(uint8_t pin_scl, uint8_t pin_sda)
 {
-    Wire.begin(pin_sda, pin_scl);
-    uint8_t wire_status = Wire.status();
+    tilt_measured = false;
+    burst_started = false;
+    motion = ACCEL_MOTION_UNKNOWN;
+    uint8_t wire_status = this->mpu6050->begin(pin_sda, pin_scl);
     
     if (wire_status != (I2C_OK))
     {
@@ -43,6 +47,8 @@ void Accelgyro::init(uint8_t pin_scl, uint8_t pin_sda)
         return;
     }
 
+    read_motion();
+
     this->mpu6050->set_clock_source(ACCEL_CLOCK);
     this->mpu6050->set_accel_range(ACCEL_RANGE);
 
@@ -54,13 +60,39 @@ void Accelgyro::init(uint8_t pin_scl, uint8_t pin_sda)
     this->mpu6050->set_stby_yg(true);
     this->mpu6050->set_stby_zg(true);
     this->mpu6050->set_lp_wake_ctrl(MPU6050_WAKE_CTRL_5HZ);
+    this->mpu6050->set_int_enable_mot(false);
+
+    /* PWR_MGMT_1 and PWR_MGMT_2 are written together in one transaction. */
+    if (!this->mpu6050->commit())
+    {
+        LOG("[ACCELGYRO_MANAGER] MPU6050 Sensor configuration failed.");
+        initialized = false;
+        return;
+    }
 
     ConfigManager& config = ConfigManager::get_instance();
-    config.get(COEFFICIENT_A, &this->coeff_a);
-    config.get(COEFFICIENT_B, &this->coeff_b);
-    config.get(COEFFICIENT_C, &this->coeff_c);
-    config.get(COEFFICIENT_D, &this->coeff_d);
-    config.get(COEFFICIENT_E, &this->coeff_e);
+    const setting coefficients[] = {COEFFICIENT_A, COEFFICIENT_B, COEFFICIENT_C, COEFFICIENT_D, COEFFICIENT_E};
+    for (size_t i = 0; i < 5; i++)
+    {
+        double coefficient = 0;
+        config.get(coefficients[i], &coefficient);
+        this->gravity_coefficients[i] = coefficient;
+    }
+
+    plato_table.init(this->gravity_coefficients);
+
+    /* A still hydrometer needs fewer samples, a disturbed one a longer window. */
+    burst_size = ACCEL_BURST_SAMPLES;
+    if (motion == ACCEL_MOTION_QUIET)
+        burst_size = ACCEL_BURST_SAMPLES_QUIET;
+    else if (motion == ACCEL_MOTION_DISTURBED)
+        burst_size = ACCEL_BURST_SAMPLES_DISTURBED;
+
+    /* The burst runs in the sensor while wifi connects, measure_tilt() only drains the FIFO. */
+    if (!start_burst())
+    {
+        LOG("[ACCELGYRO_MANAGER] FIFO burst could not be started.");
+    }
 
     initialized = true;
     LOG("[ACCELGYRO_MANAGER] MPU6050 Sensor initialization successful");
@@ -68,7 +100,31 @@ void Accelgyro::init(uint8_t pin_scl, uint8_t pin_sda)
 
 void Accelgyro::sleep()
 {
-    this->mpu6050->set_sleep(true);
+    const mpu6050_i2c_stats &stats = this->mpu6050->get_i2c_stats();
+
+    /* A burst that was not read would keep the sensor sampling continuously. */
+    if (burst_started)
+        stop_burst();
+
+    if (!initialized || !arm_motion())
+    {
+        this->mpu6050->set_sleep(true);
+        this->mpu6050->commit();
+    }
+
+    LOG("[ACCELGYRO_MANAGER] I2C transactions: " + String(stats.transactions) + ", errors: " + String(stats.errors) +
+        ", retries: " + String(stats.retries) + ", recoveries: " + String(stats.recoveries) +
+        ", max latency: " + String(stats.latency_max) + " us");
+}
+
+accel_motion Accelgyro::get_motion()
+{
+    return motion;
+}
+
+bool Accelgyro::is_contaminated()
+{
+    return (motion == ACCEL_MOTION_DISTURBED) && (tilt_dispersion > ACCEL_MOTION_DISPERSION_MAX);
 }
 
 float Accelgyro::get_plato(float temperature)
@@ -88,6 +144,12 @@ float Accelgyro::get_temperature()
 
 void Accelgyro::measure_tilt()
 {
+    vector samples[ACCEL_BURST_SAMPLES_DISTURBED];
+    size_t count;
+
+    tilt_measured = true;
+    tilt_dispersion = 0;
+
     if (!initialized)
     {
         LOG("[ACCELGYRO_MANAGER] Accelerometer data cannot be retrieved. Sensor is not initialized.");
@@ -95,44 +157,205 @@ void Accelgyro::measure_tilt()
         return;
     }
 
-    accel = this->mpu6050->get_accel_data();
-    
-    if (this->accel == MPU6050_VECTOR_READ_ERROR)
+    count = read_burst(samples, burst_size);
+    if (count == 0)
+    {
+        LOG("[ACCELGYRO_MANAGER] FIFO burst failed, single sample used.");
+        samples[0] = this->mpu6050->get_accel_data();
+        count = 1;
+    }
+
+    /* Samples read as zeros are rejected, they come from a failed transfer. */
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!(samples[i] == MPU6050_VECTOR_READ_ERROR))
+            tilts[valid++] = calculate_tilt(samples[i]);
+    }
+
+    if (valid == 0)
     {
         tilt = ACCEL_TILT_ERROR;
         LOG("[ACCELGYRO_MANAGER] Failed reading data from accelerometer!");
         return;
     }
 
-    /* Calculation of the Tilt Angle from vertical axis, in this case it is Y axis.
-     * https://www.nxp.com/docs/en/application-note/AN3461.pdf
-     */
-    tilt = acos(abs(accel.y_axis) / sqrt((accel.x_axis * accel.x_axis) + (accel.y_axis * accel.y_axis)
-                                       + (accel.z_axis * accel.z_axis))) * 180.0 / M_PI;
+    /* Trimmed mean, bumps and CO2 bubbles show up as outliers on both sides. */
+    std::sort(tilts, tilts + valid);
+    size_t trim = valid * ACCEL_BURST_TRIM_RATIO;
+    double sum = 0;
+
+    for (size_t i = trim; i < valid - trim; i++)
+        sum += tilts[i];
+
+    tilts_begin = trim;
+    tilts_end = valid - trim;
+    tilt = sum / (valid - 2 * trim);
+    tilt_dispersion = tilts[(valid * 3) / 4] - tilts[valid / 4];
+
+    LOG("[ACCELGYRO_MANAGER] Tilt: " + String(tilt) + ", dispersion: " + String(tilt_dispersion) + ", samples: " + String(valid));
+}
+
+float Accelgyro::get_tilt_dispersion()
+{
+    return tilt_dispersion;
+}
+
+bool Accelgyro::start_burst()
+{
+    /* The low power settings are restored by stop_burst(), a repeated burst keeps the ones saved first. */
+    if (!burst_started)
+    {
+        low_power_dlpf = this->mpu6050->get_dlpf_mode();
+        low_power_divider = this->mpu6050->get_sample_rate_divider();
+    }
+
+    /* Continuous measurement at the burst sample rate. */
+    this->mpu6050->set_cycle(false);
+    this->mpu6050->set_dlpf_mode(ACCEL_BURST_DLPF);
+    this->mpu6050->set_sample_rate_divider(ACCEL_BURST_SAMPLE_RATE_DIVIDER);
+
+    this->mpu6050->set_fifo_en(false);
+    this->mpu6050->set_fifo_reset(true);
+    this->mpu6050->set_fifo_en_accel(true);
+    bool status = this->mpu6050->commit();
+
+    /* FIFO reset is ignored while the FIFO is enabled, so it is enabled in a separate write. */
+    this->mpu6050->set_fifo_en(true);
+    status &= this->mpu6050->commit();
+
+    burst_started = status;
+    return status;
+}
+
+size_t Accelgyro::read_burst(vector *samples, size_t max)
+{
+    uint16_t fifo_count;
+    size_t collected;
+    size_t count;
+
+    if (!burst_started && !start_burst())
+    {
+        stop_burst();
+        return 0;
+    }
+
+    /* A full FIFO has overwritten its oldest bytes and lost the sample alignment, the burst is collected again. */
+    fifo_count = this->mpu6050->get_fifo_count();
+    if (fifo_count > MPU6050_FIFO_SIZE - MPU6050_FIFO_ACCEL_SAMPLE_SIZE)
+    {
+        LOG("[ACCELGYRO_MANAGER] FIFO overflow, burst repeated.");
+        if (!start_burst())
+        {
+            stop_burst();
+            return 0;
+        }
+
+        fifo_count = 0;
+    }
+
+    /* Usually the burst has been collected while wifi connected, otherwise the rest is sampled at the fast rate.
+       The sample in progress at the burst rate may still take a full period. */
+    collected = fifo_count / MPU6050_FIFO_ACCEL_SAMPLE_SIZE;
+    if (collected < max)
+    {
+        this->mpu6050->set_dlpf_mode(ACCEL_BURST_DLPF_FAST);
+        this->mpu6050->set_sample_rate_divider(ACCEL_BURST_SAMPLE_RATE_DIVIDER_FAST);
+        this->mpu6050->commit();
+
+        delay((max - collected) * ACCEL_BURST_SAMPLE_PERIOD_FAST + ACCEL_BURST_SAMPLE_PERIOD);
+    }
+
+    count = this->mpu6050->read_accel_samples(samples, max);
+    stop_burst();
+
+    return count;
+}
+
+void Accelgyro::stop_burst()
+{
+    this->mpu6050->set_fifo_en(false);
+    this->mpu6050->set_fifo_en_accel(false);
+    this->mpu6050->set_dlpf_mode(low_power_dlpf);
+    this->mpu6050->set_sample_rate_divider(low_power_divider);
+    this->mpu6050->set_cycle(true);
+    this->mpu6050->commit();
+    burst_started = false;
+}
+
+void Accelgyro::read_motion()
+{
+    accelgyro_rtc rtc;
+
+    /* Reading INT_STATUS clears the latched motion. */
+    if (rtc_memory_read(RTC_SLOT_ACCELGYRO, &rtc, sizeof(rtc)) && rtc.armed)
+        motion = this->mpu6050->get_int_status_mot() ? ACCEL_MOTION_DISTURBED : ACCEL_MOTION_QUIET;
+
+    rtc.armed = 0;
+    rtc.motion = motion;
+    rtc.reserved[0] = rtc.reserved[1] = 0;
+    rtc_memory_write(RTC_SLOT_ACCELGYRO, &rtc, sizeof(rtc));
+
+    LOG("[ACCELGYRO_MANAGER] Motion during sleep: " + String(motion));
+}
+
+bool Accelgyro::arm_motion()
+{
+    accelgyro_rtc rtc = {1, (uint8_t)motion, {0, 0}};
+
+    this->mpu6050->set_accel_hpf(MPU6050_ACCEL_HPF_5HZ);
+    this->mpu6050->set_mot_threshold(ACCEL_MOTION_THRESHOLD);
+    this->mpu6050->set_mot_duration(ACCEL_MOTION_DURATION);
+    this->mpu6050->set_lp_wake_ctrl(ACCEL_MOTION_WAKE_CTRL);
+    this->mpu6050->set_int_enable_mot(true);
+
+    if (!this->mpu6050->commit())
+        return false;
+
+    /* Motion detected while the device was awake is discarded. */
+    this->mpu6050->get_int_status_mot();
+
+    return rtc_memory_write(RTC_SLOT_ACCELGYRO, &rtc, sizeof(rtc));
 }
 
 void Accelgyro::calculate_plato(float temperature)
 {
-    measure_tilt();
+    if (!tilt_measured)
+        measure_tilt();
 
-    /* Gravity calculated using the formula: a*tilt^4 + b*tilt^3 + c*tilt^2 + d*tilt + e */
-    double gravity = (tilt != ACCEL_TILT_ERROR) ? (coeff_a * tilt * tilt * tilt * tilt) +
-                                                  (coeff_b * tilt * tilt * tilt) +
-                                                  (coeff_c * tilt * tilt) + (coeff_d *tilt) + coeff_e
-                                                : ACCEL_TILT_ERROR;
+    /* The Plato polynomial of the error value would overflow the fixed point range. */
+    if (tilt == ACCEL_TILT_ERROR)
+    {
+        plato = ACCEL_TILT_ERROR;
+        return;
+    }
 
-    /* Gravity correction depending on the temperature, if temperature read ok.
-       source : https://www.homebrewersassociation.org/attachments/0000/2497/Math_in_Mash_SummerZym95.pdf  */
-    if (temperature != -127)
+    /* Conversion of a sample is a table lookup, out of the table range or in a coarse cell the exact formula is used. */
+    float sum = 0;
+    for (size_t i = tilts_begin; i < tilts_end; i++)
     {
-        double t = (temperature * 1.8) + 32;  /**< Temperature in Fahrenheit. */
-        double sg_correction_factor = 1.00130346 - 1.34722124 * 10e-04 * t +
-                                    2.04052596 * 10e-06 * t * t - 2.32820948 * 10e-09 * t * t * t;
-        gravity *= sg_correction_factor;
+        float value;
+
+        if (!plato_table.lookup(tilts[i], temperature, &value))
+            value = PlatoTable::calculate(gravity_coefficients, tilts[i], temperature);
+
+        sum += value;
     }
 
-    /* Math in  mash SummerZym95 <- formula (7). */
-    plato = (-1 * 668.962) + (1262.45 * gravity) - (776.43 * gravity * gravity) + (182.94 * gravity * gravity * gravity);
+    plato = sum / (tilts_end - tilts_begin);
+
+    LOG("[ACCELGYRO_MANAGER] Plato table error: " + String(plato_table.get_error_max(), 4) + " P");
+}
+
+/**
+ * @brief Calculation of the Tilt Angle from vertical axis, in this case it is Y axis.
+ *        https://www.nxp.com/docs/en/application-note/AN3461.pdf
+ * @return float - tilt in degrees
+ */
+static float calculate_tilt(const vector &accel)
+{
+    return acos(abs(accel.y_axis) / sqrt(((float)accel.x_axis * accel.x_axis) + ((float)accel.y_axis * accel.y_axis)
+                                        + ((float)accel.z_axis * accel.z_axis))) * 180.0 / M_PI;
 }
 
 /**
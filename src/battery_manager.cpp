@@ -33,7 +33,7 @@ void BatteryManager::check()
 {
     /* If the voltage level is critical, the program cannot be allowed to run. */
     if (!this->init())
-        ESP.deepSleep(ESP.deepSleepMax(), RF_DISABLED);
+        ESP.deepSleep(time_prepare_sleep(ESP.deepSleepMax()), RF_DISABLED);
 }
 
 
@@ -13,13 +13,16 @@
 
 ConfigManager::ConfigManager()
 {
-    LittleFS.begin();
+    this->loaded = false;
+    this->restored = false;
     this->ssid = new char[32];
     this->pass = new char[32];
     this->api_key = new char[64];
     this->email = new char[64];
     this->firebase_password = new char[32];
     this->database_url = new char[128];
+    this->ssid[0] = this->pass[0] = this->api_key[0] = '\0';
+    this->email[0] = this->firebase_password[0] = this->database_url[0] = '\0';
 }
 
 ConfigManager::~ConfigManager()
@@ -40,27 +43,41 @@ ConfigManager& ConfigManager::get_instance()
 void ConfigManager::init()
 {
     int cnt = 0;
+
+    if (load_rtc())
+    {
+        LOG("[CONFIG MANAGER] Config restored from RTC memory");
+        return;
+    }
+
     while(!load())
     {
         LOG("[CONFIG MANAGER] Config load failed, retry :" + String(++cnt));
         if (cnt == CONFIG_MAX_READING_ATTEMPS)
         {
             LOG("[CONFIG MANAGER] Could not load config!");
-            ESP.deepSleep(ESP.deepSleepMax());
+            ESP.deepSleep(time_prepare_sleep(ESP.deepSleepMax()));
         }
     }
 
     if(!is_device_configured())
     {
         LOG("CONFIG MANAGER] Config file is incomplete!");
-        ESP.deepSleep(ESP.deepSleepMax());
+        ESP.deepSleep(time_prepare_sleep(ESP.deepSleepMax()));
     }
 
+    save_rtc();
     LOG("[CONFIG MANAGER] Config loaded");
 }
 
 bool ConfigManager::load()
 {
+    if (!LittleFS.begin())
+    {
+        LOG("[CONFIG_MANAGER] Could not mount filesystem!");
+        return false;
+    }
+
     File configFile = LittleFS.open("/config.json", "r");
     if (!configFile)
     {
@@ -69,16 +86,17 @@ bool ConfigManager::load()
     }
     
     size_t size = configFile.size();
-    char *buf = new char[size];
+    char *buf = new char[size + 1];
     
     configFile.readBytes(buf, size);
+    buf[size] = '\0';
     
     StaticJsonBuffer <200> jsonBuffer;
     JsonObject& json = jsonBuffer.parseObject(buf);
     
     if (!json.success())
     {
-        delete buf;
+        delete[] buf;
         configFile.close();
         LOG("[CONFIG_MANAGER] JSON parsing failed");
         return false;
@@ -97,8 +115,9 @@ bool ConfigManager::load()
     this->coeff_d = strtod(json["coeff_d" ], NULL);
     this->coeff_e = strtod(json["coeff_e" ], NULL);
 
-    delete buf;
+    delete[] buf;
     configFile.close();
+    this->loaded = true;
     return true;
 }
 
@@ -125,11 +144,16 @@ bool ConfigManager::save()
     }
     json.printTo(configFile);
     configFile.close();
+    save_rtc();
     return true; 
 }
 
 bool ConfigManager::is_device_configured()
 {
+    /* Only a complete config is saved in RTC memory. */
+    if (!this->loaded)
+        return this->restored;
+
     return ((this->ssid[0] != '\0')             &&
            (this->pass[0] != '\0')              &&
            (this->email[0] != '\0')             &&
@@ -140,6 +164,10 @@ bool ConfigManager::is_device_configured()
 
 void ConfigManager::get(setting setting, char *&buf)
 {
+    /* Firebase settings are not kept in RTC memory. */
+    if (!this->loaded && (setting != WIFI_PASSWOWRD) && (setting != WIFI_SSID))
+        load();
+
     switch (setting)
     {
     case WIFI_PASSWOWRD:    buf = this->pass; break;
@@ -218,4 +246,44 @@ void ConfigManager::set(setting setting, double buf)
     }
 }
 
+bool ConfigManager::load_rtc()
+{
+    config_rtc cfg;
+
+    /* After other resets the config file could have been changed. */
+    if (ESP.getResetInfoPtr()->reason != REASON_DEEP_SLEEP_AWAKE)
+        return false;
+
+    if (!rtc_memory_read(RTC_SLOT_CONFIG, &cfg, sizeof(cfg)))
+        return false;
+
+    memcpy(this->ssid, cfg.ssid, sizeof(cfg.ssid));
+    memcpy(this->pass, cfg.pass, sizeof(cfg.pass));
+    this->sleep_time = cfg.sleep_time;
+    this->coeff_a = cfg.coeff_a;
+    this->coeff_b = cfg.coeff_b;
+    this->coeff_c = cfg.coeff_c;
+    this->coeff_d = cfg.coeff_d;
+    this->coeff_e = cfg.coeff_e;
+
+    this->restored = true;
+    return true;
+}
+
+void ConfigManager::save_rtc()
+{
+    config_rtc cfg;
+
+    memcpy(cfg.ssid, this->ssid, sizeof(cfg.ssid));
+    memcpy(cfg.pass, this->pass, sizeof(cfg.pass));
+    cfg.sleep_time = this->sleep_time;
+    cfg.coeff_a = this->coeff_a;
+    cfg.coeff_b = this->coeff_b;
+    cfg.coeff_c = this->coeff_c;
+    cfg.coeff_d = this->coeff_d;
+    cfg.coeff_e = this->coeff_e;
+
+    rtc_memory_write(RTC_SLOT_CONFIG, &cfg, sizeof(cfg));
+}
+
 ConfigManager ConfigManager::instance;
@@ -0,0 +1,354 @@
+/**
+ * @file data_log.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <data_log.h>
+#include <log_debug.h>
+
+//--------------------------------------------------------------------------------
+
+DataLog::DataLog(const char *path, uint16_t pages)
+{
+    this->path = path;
+    this->pages = pages;
+    this->initialized = false;
+}
+
+bool DataLog::begin()
+{
+    if (this->initialized)
+        return true;
+
+    /* The filesystem is mounted only when the log is used. */
+    if (!LittleFS.begin())
+    {
+        LOG("[DATA_LOG] Could not mount filesystem!");
+        return false;
+    }
+
+    File file = LittleFS.open(this->path, "r");
+    if (file)
+    {
+        size_t size = file.read((uint8_t *)&this->header, sizeof(this->header));
+        file.close();
+
+        this->initialized = (size == sizeof(this->header))                                              &&
+                            (this->header.magic == DATA_LOG_MAGIC)                                      &&
+                            (this->header.version == DATA_LOG_VERSION)                                  &&
+                            (this->header.codec_version == MEASUREMENT_CODEC_VERSION)                   &&
+                            (this->header.page_size == DATA_LOG_PAGE_SIZE)                              &&
+                            (this->header.pages == this->pages)                                         &&
+                            (this->header.crc == crc32(&this->header, offsetof(data_log_header, crc)))  &&
+                            (this->header.head - this->header.tail < this->pages);
+    }
+
+    if (!this->initialized)
+    {
+        LOG("[DATA_LOG] Log file not valid, formatting.");
+        this->initialized = format();
+    }
+
+    return this->initialized;
+}
+
+bool DataLog::append(const data &measurement)
+{
+    return append(&measurement, 1);
+}
+
+bool DataLog::append(const data *records, size_t count)
+{
+    data temp;
+    size_t offset = 0;
+    bool status = true;
+
+    if (!begin())
+        return false;
+
+    File file = LittleFS.open(this->path, "r+");
+    if (!file)
+        return false;
+
+    if (!read_page(file, this->header.head, &this->page))
+    {
+        LOG("[DATA_LOG] Corrupted head page replaced.");
+        recount(file);
+        this->page.header.sequence = this->header.head;
+        this->page.header.count = 0;
+        this->page.header.size = 0;
+    }
+
+    /* Restore the encoder state from the records already in the page. */
+    this->codec.reset();
+    for (uint16_t i = 0; i < this->page.header.count; i++)
+        offset += this->codec.decode(&this->page.records[offset], this->page.header.size - offset, &temp);
+
+    for (size_t i = 0; (i < count) && status; i++)
+    {
+        size_t length = this->codec.encode(records[i], &this->page.records[this->page.header.size],
+                                           sizeof(this->page.records) - this->page.header.size);
+        if (length == 0)
+        {
+            /* The head page is full, start a new one. If all pages are used, the oldest is overwritten. */
+            status = write_page(file, &this->page);
+
+            if (this->header.head - this->header.tail + 2 > this->pages)
+            {
+                LOG("[DATA_LOG] Log full, the oldest page overwritten.");
+                drop_tail_page(file);
+            }
+
+            this->header.head++;
+            this->page.header.sequence = this->header.head;
+            this->page.header.count = 0;
+            this->page.header.size = 0;
+            this->codec.reset();
+            length = this->codec.encode(records[i], this->page.records, sizeof(this->page.records));
+        }
+
+        this->page.header.count++;
+        this->page.header.size += length;
+        this->header.count++;
+    }
+
+    status = status && write_page(file, &this->page) && write_header(file);
+    file.close();
+
+    if (!status)
+    {
+        LOG("[DATA_LOG] Record write failed!");
+    }
+
+    return status;
+}
+
+size_t DataLog::read(data *records, size_t max)
+{
+    uint32_t skip;
+    size_t count = 0;
+    bool modified = false;
+
+    if (!begin())
+        return 0;
+
+    File file = LittleFS.open(this->path, "r+");
+    if (!file)
+        return 0;
+
+    skip = this->header.tail_index;
+    for (uint32_t sequence = this->header.tail; (count < max) && (sequence - this->header.tail <= this->header.head - this->header.tail); sequence++)
+    {
+        size_t offset = 0;
+
+        if (!read_page(file, sequence, &this->page))
+        {
+            /* Records after the corrupted page are returned once it reaches the tail. */
+            if (count > 0)
+                break;
+
+            LOG("[DATA_LOG] Corrupted page removed: " + String(sequence));
+            drop_tail_page(file);
+            modified = true;
+            skip = this->header.tail_index;
+            sequence = this->header.tail - 1;
+            continue;
+        }
+
+        this->codec.reset();
+        for (uint16_t i = 0; (i < this->page.header.count) && (count < max); i++)
+        {
+            data temp;
+            size_t length = this->codec.decode(&this->page.records[offset], this->page.header.size - offset, &temp);
+            if (length == 0)
+                break;
+
+            offset += length;
+            if (i >= skip)
+                records[count++] = temp;
+        }
+
+        skip = 0;
+    }
+
+    if (modified)
+        write_header(file);
+
+    file.close();
+    return count;
+}
+
+void DataLog::drop(uint32_t count)
+{
+    if (!begin() || (count == 0))
+        return;
+
+    File file = LittleFS.open(this->path, "r+");
+    if (!file)
+        return;
+
+    count = std::min(count, this->header.count);
+    while (count > 0)
+    {
+        uint32_t remaining;
+
+        if (!read_page(file, this->header.tail, &this->page))
+        {
+            drop_tail_page(file);
+            break;
+        }
+
+        remaining = this->page.header.count - this->header.tail_index;
+        if ((count < remaining) || (this->header.tail == this->header.head))
+        {
+            remaining = std::min(count, remaining);
+            this->header.tail_index += remaining;
+            this->header.count -= remaining;
+            break;
+        }
+
+        count -= remaining;
+        this->header.count -= remaining;
+        this->header.tail++;
+        this->header.tail_index = 0;
+    }
+
+    write_header(file);
+    file.close();
+}
+
+uint32_t DataLog::count()
+{
+    if (!begin())
+        return 0;
+
+    return this->header.count;
+}
+
+bool DataLog::format()
+{
+    File file = LittleFS.open(this->path, "w");
+    if (!file)
+    {
+        LOG("[DATA_LOG] Could not create log file!");
+        return false;
+    }
+
+    this->header.magic = DATA_LOG_MAGIC;
+    this->header.version = DATA_LOG_VERSION;
+    this->header.codec_version = MEASUREMENT_CODEC_VERSION;
+    this->header.page_size = DATA_LOG_PAGE_SIZE;
+    this->header.pages = this->pages;
+    this->header.head = 0;
+    this->header.tail = 0;
+    this->header.tail_index = 0;
+    this->header.count = 0;
+
+    if (!write_header(file))
+    {
+        file.close();
+        return false;
+    }
+
+    this->page.header.sequence = 0;
+    this->page.header.count = 0;
+    this->page.header.size = 0;
+    if (!write_page(file, &this->page))
+    {
+        file.close();
+        return false;
+    }
+
+    /* Preallocate all pages, so appending never changes the size of the file. */
+    memset(&this->page, 0xFF, sizeof(this->page));
+    for (uint16_t i = 1; i < this->pages; i++)
+    {
+        if (file.write((uint8_t *)&this->page, sizeof(this->page)) != sizeof(this->page))
+        {
+            file.close();
+            LOG("[DATA_LOG] Log file preallocation failed!");
+            return false;
+        }
+    }
+
+    file.close();
+    return true;
+}
+
+bool DataLog::write_header(File &file)
+{
+    this->header.crc = crc32(&this->header, offsetof(data_log_header, crc));
+
+    file.seek(0);
+    return (file.write((uint8_t *)&this->header, sizeof(this->header)) == sizeof(this->header));
+}
+
+bool DataLog::read_page(File &file, uint32_t sequence, data_log_page *page)
+{
+    file.seek(page_offset(sequence));
+    if (file.read((uint8_t *)page, sizeof(*page)) != sizeof(*page))
+        return false;
+
+    if ((page->header.sequence != sequence) || (page->header.size > sizeof(page->records)))
+        return false;
+
+    uint32_t crc = crc32(&page->header, offsetof(data_log_page_header, crc));
+    return (page->header.crc == crc32(page->records, page->header.size, crc));
+}
+
+bool DataLog::write_page(File &file, data_log_page *page)
+{
+    uint32_t crc = crc32(&page->header, offsetof(data_log_page_header, crc));
+    page->header.crc = crc32(page->records, page->header.size, crc);
+
+    file.seek(page_offset(page->header.sequence));
+    return (file.write((uint8_t *)page, sizeof(*page)) == sizeof(*page));
+}
+
+void DataLog::drop_tail_page(File &file)
+{
+    bool valid = read_page(file, this->header.tail, &this->page);
+
+    if (valid)
+        this->header.count -= std::min(this->header.count, (uint32_t)(this->page.header.count - this->header.tail_index));
+
+    /* The head page cannot be removed, it is replaced with an empty one. */
+    if (this->header.tail == this->header.head)
+    {
+        this->header.head++;
+        this->page.header.sequence = this->header.head;
+        this->page.header.count = 0;
+        this->page.header.size = 0;
+        write_page(file, &this->page);
+    }
+
+    this->header.tail++;
+    this->header.tail_index = 0;
+
+    if (!valid)
+        recount(file);
+}
+
+void DataLog::recount(File &file)
+{
+    this->header.count = 0;
+
+    for (uint32_t sequence = this->header.tail; sequence - this->header.tail <= this->header.head - this->header.tail; sequence++)
+    {
+        if (!read_page(file, sequence, &this->page))
+            continue;
+
+        this->header.count += this->page.header.count;
+        if (sequence == this->header.tail)
+            this->header.count -= std::min((uint32_t)this->page.header.count, this->header.tail_index);
+    }
+}
+
+uint32_t DataLog::page_offset(uint32_t sequence)
+{
+    return sizeof(data_log_header) + ((sequence % this->pages) * sizeof(data_log_page));
+}
@@ -0,0 +1,118 @@
+/**
+ * @file data_staging.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <data_staging.h>
+#include <log_debug.h>
+
+//--------------------------------------------------------------------------------
+
+DataStaging::DataStaging()
+{
+    this->loaded = false;
+}
+
+bool DataStaging::append(const data &measurement)
+{
+    size_t length;
+
+    load();
+
+    length = this->codec.encode(measurement, &this->buffer.records[this->buffer.size],
+                                sizeof(this->buffer.records) - this->buffer.size);
+    if (length == 0)
+        return false;
+
+    this->buffer.count++;
+    this->buffer.size += length;
+
+    if (!rtc_memory_write(RTC_SLOT_STAGING, &this->buffer, sizeof(this->buffer)))
+    {
+        LOG("[DATA_STAGING] RTC memory write failed!");
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+size_t DataStaging::read(data *records, size_t max)
+{
+    MeasurementCodec decoder;
+    size_t offset = 0;
+    size_t count = 0;
+
+    load();
+
+    while ((count < this->buffer.count) && (count < max))
+    {
+        size_t length = decoder.decode(&this->buffer.records[offset], this->buffer.size - offset, &records[count]);
+        if (length == 0)
+            break;
+
+        offset += length;
+        count++;
+    }
+
+    return count;
+}
+
+void DataStaging::clear()
+{
+    this->buffer.count = 0;
+    this->buffer.codec_version = MEASUREMENT_CODEC_VERSION;
+    this->buffer.size = 0;
+    this->codec.reset();
+    this->loaded = true;
+
+    rtc_memory_write(RTC_SLOT_STAGING, &this->buffer, sizeof(this->buffer));
+}
+
+uint32_t DataStaging::count()
+{
+    load();
+    return this->buffer.count;
+}
+
+void DataStaging::load()
+{
+    data temp;
+    size_t offset = 0;
+
+    if (this->loaded)
+        return;
+
+    this->loaded = true;
+    this->codec.reset();
+
+    /* Records of another encoding, staged before a firmware update, cannot be decoded. */
+    if (!rtc_memory_read(RTC_SLOT_STAGING, &this->buffer, sizeof(this->buffer)) ||
+        (this->buffer.codec_version != MEASUREMENT_CODEC_VERSION) ||
+        (this->buffer.size > sizeof(this->buffer.records)))
+    {
+        this->buffer.count = 0;
+        this->buffer.codec_version = MEASUREMENT_CODEC_VERSION;
+        this->buffer.size = 0;
+        return;
+    }
+
+    /* The encoder continues the stream, so it is moved past the staged records. */
+    for (uint8_t i = 0; i < this->buffer.count; i++)
+    {
+        size_t length = this->codec.decode(&this->buffer.records[offset], this->buffer.size - offset, &temp);
+        if (length == 0)
+        {
+            LOG("[DATA_STAGING] Corrupted record, " + String(this->buffer.count - i) + " measurements lost.");
+            this->buffer.count = i;
+            this->buffer.size = offset;
+            break;
+        }
+
+        offset += length;
+    }
+}
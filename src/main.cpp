@@ -16,6 +16,10 @@
 #include <wifi_manager.h>
 #include <sender.h>
 #include <log_debug.h>
+#include <rtc_memory.h>
+#include <profiler.h>
+#include <scheduler.h>
+#include <coredecls.h>
 
 //--------------------------------------------------------------------------------
 
@@ -36,6 +40,7 @@
 
 ConfigManager& config = ConfigManager::get_instance(); /**< Config singleton instance. */
 Sender& sender = Sender::get_instance();               /**< Firebase sender singleton instance. */
+Profiler& profiler = Profiler::get_instance();         /**< Wake-up profiler singleton instance. */
 static WifiManager wifi;               /**< WiFi instance. */
 static BatteryManager battery;         /**< Battery manager instance. */
 static Temperature temperature;        /**< Temperature DS18B20 sensor instance. */
@@ -53,6 +58,21 @@ enum
     CRITICAL_BATTERY        /**< Battery status is critical, in this mode, the device immediately goes to sleep. */
 } device_mode;
 
+/** @brief Result of the connection and upload in this wake-up, drives the backoff of the next one. */
+enum
+{
+    ATTEMPT_NONE,       /**< Connection was not attempted, the backoff is kept. */
+    ATTEMPT_SUCCEEDED,  /**< The measurement was uploaded, the backoff is cleared. */
+    ATTEMPT_FAILED      /**< Connection or upload failed, the backoff window doubles. */
+} attempt;
+
+/** @brief Wake-up backoff state kept in RTC memory across deep sleep. */
+struct scheduler_rtc
+{
+    uint8_t failures;       /**< Number of consecutive wake-ups with a failed connection or upload. */
+    uint8_t reserved[3];    /**< Padding. */
+};
+
 //--------------------------------------------------------------------------------
 /* Private functions declarations. */
 
@@ -62,25 +82,54 @@ void default_wifi_setup();
 /** @brief Wifi setup when battery status is low. */
 void battery_saving_wifi_setup();
 
+/**
+ * @brief Schedules the next wake-up on the sleep time grid, shifted by the per-device offset
+ *        so a fleet does not connect at once, and delayed by a random backoff after failures.
+ * @return uint64_t - sleep duration in microseconds
+ */
+uint64_t schedule_sleep();
+
+/**
+ * @brief Numbers the measurement, the counter is kept in RTC memory. After power-up it starts at a random value,
+ *        so measurements without time do not get the keys of the ones taken before the power loss.
+ * @return uint32_t - sequence number of the measurement
+ */
+uint32_t next_sequence();
+
 //--------------------------------------------------------------------------------
 
 void default_wifi_setup()
 {
+    profiler.begin(PROFILER_PHASE_WIFI);
     wifi.begin();
+    profiler.end();
+
+    profiler.begin(PROFILER_PHASE_AUTH);
     sender.init();
+    profiler.end();
+
     device_mode = wifi.is_connected() ? DEFAULT_ONLINE : DEFAULT_OFFLINE;
+    attempt = wifi.is_connected() ? ATTEMPT_NONE : ATTEMPT_FAILED;
 }
 
 void battery_saving_wifi_setup()
 {
     uint32_t offline_wake_counter;
-    ESP.rtcUserMemoryRead(0, &offline_wake_counter, sizeof(offline_wake_counter));
+
+    /* After power-up try to connect immediately. */
+    if (!rtc_memory_read(RTC_SLOT_OFFLINE_WAKE_COUNTER, &offline_wake_counter, sizeof(offline_wake_counter)))
+        offline_wake_counter = BATTERY_SAVING_OFFLINE_MODE_MAX;
 
     if (offline_wake_counter >= BATTERY_SAVING_OFFLINE_MODE_MAX)
     {
+        profiler.begin(PROFILER_PHASE_WIFI);
         wifi.begin();
+        profiler.end();
+
+        profiler.begin(PROFILER_PHASE_AUTH);
         sender.init();
-        
+        profiler.end();
+
         if (wifi.is_connected())
         {
             device_mode = BATTERY_SAVING_ONLINE;
@@ -89,6 +138,7 @@ void battery_saving_wifi_setup()
         else
         {
             device_mode = BATTERY_SAVING_OFFLINE;
+            attempt = ATTEMPT_FAILED;
             offline_wake_counter ++;
         }
     }
@@ -98,14 +148,51 @@ void battery_saving_wifi_setup()
         offline_wake_counter ++;
     }
 
-    ESP.rtcUserMemoryWrite(0, &offline_wake_counter, sizeof(offline_wake_counter));
+    rtc_memory_write(RTC_SLOT_OFFLINE_WAKE_COUNTER, &offline_wake_counter, sizeof(offline_wake_counter));
+}
+
+uint64_t schedule_sleep()
+{
+    scheduler_rtc state;
+    uint32_t chip_id = ESP.getChipId();
+
+    if (!rtc_memory_read(RTC_SLOT_SCHEDULER, &state, sizeof(state)))
+        state = {0, {0, 0, 0}};
+
+    if (attempt == ATTEMPT_SUCCEEDED)
+        state.failures = 0;
+    else if ((attempt == ATTEMPT_FAILED) && (state.failures < UINT8_MAX))
+        state.failures++;
+
+    uint64_t sleep = scheduler_sleep(get_time_since_epoch_us(), sleep_time, crc32(&chip_id, sizeof(chip_id)), state.failures, ESP.random());
+
+    rtc_memory_write(RTC_SLOT_SCHEDULER, &state, sizeof(state));
+    LOG("[MAIN] Failed wake-ups: " + String(state.failures));
+    return sleep;
+}
+
+uint32_t next_sequence()
+{
+    uint32_t sequence;
+    uint32_t next;
+
+    if (!rtc_memory_read(RTC_SLOT_SEQUENCE, &sequence, sizeof(sequence)))
+        sequence = ESP.random();
+
+    next = sequence + 1;
+    rtc_memory_write(RTC_SLOT_SEQUENCE, &next, sizeof(next));
+    return sequence;
 }
 
 //--------------------------------------------------------------------------------
 
 void setup() 
 {
+    profiler.init();
+
+    profiler.begin(PROFILER_PHASE_BATTERY);
     battery.check();
+    profiler.end();
 
 #if LOG_DEBUG == LOG_SERIAL
     Serial.begin(9600);
@@ -115,8 +202,19 @@ void setup()
     LOG("[MAIN SETUP] Reset reason: " + String(ESP.getResetReason()));
     LOG("[MAIN SETIP] BATTERY STATUS : " + String(battery_status_to_str[battery.get_battery_status()]));
 
+    profiler.begin(PROFILER_PHASE_CONFIG);
     config.init();
     config.get(SLEEP_TIME, &sleep_time);
+    profiler.end();
+
+    /* The temperature conversion and the tilt burst run in the sensors while wifi connects. */
+    profiler.begin(PROFILER_PHASE_TEMPERATURE);
+    temperature.init(ONE_WIRE_BUS);
+    profiler.end();
+
+    profiler.begin(PROFILER_PHASE_TILT);
+    accelgyro.init(I2C_SCL, I2C_SDA);
+    profiler.end();
 
     switch (battery.get_battery_status())
     {
@@ -128,9 +226,6 @@ void setup()
         default_wifi_setup(); break;
     }
 
-    accelgyro.init(I2C_SCL, I2C_SDA);
-    temperature.init(ONE_WIRE_BUS);
-
     LOG("[MAIN SETUP] Setup time: " + String(millis()) + " ms");
 }
 
@@ -139,29 +234,77 @@ void setup()
 /* Main process. Should be executed only once. */
 void loop()
 {
+    profiler.begin(PROFILER_PHASE_BATTERY);
     measurement.battery_voltage = battery.get_voltage();
+    profiler.end();
+
+    profiler.begin(PROFILER_PHASE_TILT);
+    accelgyro.measure_tilt();
+    profiler.end();
+
+    profiler.begin(PROFILER_PHASE_TEMPERATURE);
     measurement.temperature = temperature.get_temp();
+    profiler.end();
+
+    profiler.begin(PROFILER_PHASE_TILT);
     measurement.plato = accelgyro.get_plato(measurement.temperature);
+    profiler.end();
+
+    measurement.time = get_time_since_epoch();
+    measurement.sequence = next_sequence();
     
+    /* A reading taken while the hydrometer still moves after a disturbance is not stored, the backlog is still sent. */
+    bool contaminated = accelgyro.is_contaminated();
+    if (contaminated)
+    {
+        LOG("[MAIN] Hydrometer disturbed during sleep, measurement skipped.");
+    }
+
     switch (device_mode)
     {
     case DEFAULT_ONLINE:
     case BATTERY_SAVING_ONLINE:
-        sender.send_data(&measurement);
+        profiler.begin(PROFILER_PHASE_UPLOAD);
+        attempt = sender.send_data(contaminated ? nullptr : &measurement) ? ATTEMPT_SUCCEEDED : ATTEMPT_FAILED;
+        profiler.end();
         break;
     case DEFAULT_OFFLINE:
     case BATTERY_SAVING_OFFLINE:
-        sender.save_data(measurement);
+        if (!contaminated)
+        {
+            profiler.begin(PROFILER_PHASE_FLASH);
+            sender.save_data(measurement);
+            profiler.end();
+        }
         break;
     case CRITICAL_BATTERY:
         break;
     }
 
+    /* A cached lease that does not carry traffic may conflict with another host. */
+    if (wifi.is_connected() && (!time_is_synchronized() || (attempt == ATTEMPT_FAILED)))
+        wifi.drop_cached_lease();
+
+    /* The summary of the previous wake-ups is uploaded once it covers enough of them. */
+    if (((device_mode == DEFAULT_ONLINE) || (device_mode == BATTERY_SAVING_ONLINE)) && profiler.is_summary_due())
+    {
+        profiler.begin(PROFILER_PHASE_UPLOAD);
+        if (sender.send_profile(profiler.get_summary()))
+            profiler.clear_summary();
+        profiler.end();
+    }
+
+    profiler.begin(PROFILER_PHASE_SLEEP);
+    uint64_t sleep = schedule_sleep();
+
     LOG("[MAIN] Program execution time :" + String(millis()) + " ms");
-    LOG("[MAIN] Deep Sleep for : " + String(sleep_time/60000000) + "min");
+    LOG("[MAIN] Deep Sleep for : " + String((uint32_t)(sleep / 1000000)) + " s");
     temperature.sleep();
     accelgyro.sleep();
-    ESP.deepSleep(sleep_time);
+    sleep = time_prepare_sleep(sleep);
+    profiler.end();
+    profiler.save();
+    ESP.deepSleep(sleep);
 
     LOG("[MAIN] SHOULD NEVER BE HERE!");
 }
@@ -0,0 +1,169 @@
+/**
+ * @file measurement_codec.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <math.h>
+#include <measurement_codec.h>
+
+//--------------------------------------------------------------------------------
+/* Private function declarations. */
+
+static size_t write_varint(uint32_t value, uint8_t *buf);
+static size_t read_varint(const uint8_t *buf, size_t size, uint32_t *value);
+static uint32_t zigzag_encode(int32_t value);
+static int32_t zigzag_decode(uint32_t value);
+static int32_t saturate(float value);
+
+//--------------------------------------------------------------------------------
+
+MeasurementCodec::MeasurementCodec()
+{
+    reset();
+}
+
+void MeasurementCodec::reset()
+{
+    previous = measurement_fixed{};
+    time_interval = 0;
+}
+
+size_t MeasurementCodec::encode(const data &measurement, uint8_t *buf, size_t size)
+{
+    uint8_t record[MEASUREMENT_CODEC_MAX_SIZE];
+    measurement_fixed fixed = to_fixed(measurement);
+    uint32_t interval = fixed.time - previous.time;
+    size_t length = 0;
+
+    /* Differences are calculated modulo 2^32, so every value can be restored exactly. */
+    length += write_varint(zigzag_encode((int32_t)(interval - time_interval)), &record[length]);
+    length += write_varint(zigzag_encode((int32_t)((uint32_t)fixed.temperature - (uint32_t)previous.temperature)), &record[length]);
+    length += write_varint(zigzag_encode((int32_t)((uint32_t)fixed.plato - (uint32_t)previous.plato)), &record[length]);
+    length += write_varint(zigzag_encode((int32_t)((uint32_t)fixed.voltage - (uint32_t)previous.voltage)), &record[length]);
+    length += write_varint(zigzag_encode((int32_t)(fixed.sequence - previous.sequence - 1)), &record[length]);
+
+    if (length > size)
+        return 0;
+
+    for (size_t i = 0; i < length; i++)
+        buf[i] = record[i];
+
+    previous = fixed;
+    time_interval = interval;
+    return length;
+}
+
+size_t MeasurementCodec::decode(const uint8_t *buf, size_t size, data *measurement)
+{
+    uint32_t fields[5];
+    size_t length = 0;
+
+    for (int i = 0; i < 5; i++)
+    {
+        size_t field_length = read_varint(&buf[length], size - length, &fields[i]);
+        if (field_length == 0)
+            return 0;
+
+        length += field_length;
+    }
+
+    time_interval += (uint32_t)zigzag_decode(fields[0]);
+    previous.time += time_interval;
+    previous.temperature = (int32_t)((uint32_t)previous.temperature + (uint32_t)zigzag_decode(fields[1]));
+    previous.plato = (int32_t)((uint32_t)previous.plato + (uint32_t)zigzag_decode(fields[2]));
+    previous.voltage = (int32_t)((uint32_t)previous.voltage + (uint32_t)zigzag_decode(fields[3]));
+    previous.sequence += (uint32_t)zigzag_decode(fields[4]) + 1;
+
+    *measurement = from_fixed(previous);
+    return length;
+}
+
+measurement_fixed MeasurementCodec::to_fixed(const data &measurement)
+{
+    measurement_fixed fixed;
+
+    fixed.time = measurement.time;
+    fixed.temperature = saturate(measurement.temperature * MEASUREMENT_CODEC_TEMPERATURE_SCALE);
+    fixed.plato = saturate(measurement.plato * MEASUREMENT_CODEC_PLATO_SCALE);
+    fixed.voltage = saturate(measurement.battery_voltage * MEASUREMENT_CODEC_VOLTAGE_SCALE);
+    fixed.sequence = measurement.sequence;
+    return fixed;
+}
+
+data MeasurementCodec::from_fixed(const measurement_fixed &fixed)
+{
+    data measurement;
+
+    measurement.time = fixed.time;
+    measurement.temperature = (float)fixed.temperature / MEASUREMENT_CODEC_TEMPERATURE_SCALE;
+    measurement.plato = (float)fixed.plato / MEASUREMENT_CODEC_PLATO_SCALE;
+    measurement.battery_voltage = (float)fixed.voltage / MEASUREMENT_CODEC_VOLTAGE_SCALE;
+    measurement.sequence = fixed.sequence;
+    return measurement;
+}
+
+/**
+ * @brief Writes the value as LEB128 varint, 7 bits per byte, the oldest bit marks the next byte.
+ * @return size_t - number of bytes written, at most 5
+ */
+static size_t write_varint(uint32_t value, uint8_t *buf)
+{
+    size_t length = 0;
+
+    while (value >= 0x80)
+    {
+        buf[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+
+    buf[length++] = (uint8_t)value;
+    return length;
+}
+
+/**
+ * @brief Reads LEB128 varint.
+ * @return size_t - number of bytes read, 0 if truncated or longer than 5 bytes
+ */
+static size_t read_varint(const uint8_t *buf, size_t size, uint32_t *value)
+{
+    *value = 0;
+
+    for (size_t i = 0; (i < size) && (i < 5); i++)
+    {
+        *value |= (uint32_t)(buf[i] & 0x7F) << (7 * i);
+        if (!(buf[i] & 0x80))
+            return i + 1;
+    }
+
+    return 0;
+}
+
+/** @brief Maps signed values to unsigned ones, so small differences of both signs have short varints. */
+static uint32_t zigzag_encode(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t zigzag_decode(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+/** @brief Rounds to the nearest integer, values out of the int32_t range are saturated, NaN gives 0. */
+static int32_t saturate(float value)
+{
+    if (isnan(value))
+        return 0;
+
+    if (value >= 2147483520.0f)
+        return INT32_MAX;
+
+    if (value <= -2147483648.0f)
+        return INT32_MIN;
+
+    return (int32_t)lroundf(value);
+}
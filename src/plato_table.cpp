@@ -0,0 +1,121 @@
+/**
+ * @file plato_table.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <math.h>
+#include <plato_table.h>
+
+//--------------------------------------------------------------------------------
+
+PlatoTable::PlatoTable()
+{
+    this->ready = false;
+}
+
+void PlatoTable::init(const float (&coefficients)[5])
+{
+    for (size_t i = 0; i < 5; i++)
+        this->coefficients[i] = coefficients[i];
+
+    for (size_t i = 0; i < PLATO_TABLE_TILT_SIZE; i++)
+    {
+        for (size_t j = 0; j < PLATO_TABLE_TEMPERATURE_SIZE; j++)
+            this->values[i][j] = PLATO_TABLE_EMPTY;
+    }
+
+    for (size_t i = 0; i < PLATO_TABLE_TILT_SIZE - 1; i++)
+    {
+        for (size_t j = 0; j < PLATO_TABLE_TEMPERATURE_SIZE - 1; j++)
+            this->cells[i][j] = PLATO_TABLE_CELL_UNCHECKED;
+    }
+
+    this->error_max = 0;
+    this->ready = true;
+}
+
+bool PlatoTable::lookup(float tilt, float temperature, float *plato)
+{
+    float x = (tilt - PLATO_TABLE_TILT_MIN) / PLATO_TABLE_TILT_STEP;
+    float y = (temperature - PLATO_TABLE_TEMPERATURE_MIN) / PLATO_TABLE_TEMPERATURE_STEP;
+
+    /* Written as negations to reject NaN as well. */
+    if (!this->ready || !(x >= 0) || !(y >= 0) || !(x <= PLATO_TABLE_TILT_SIZE - 1) || !(y <= PLATO_TABLE_TEMPERATURE_SIZE - 1))
+        return false;
+
+    size_t i = (x < PLATO_TABLE_TILT_SIZE - 1) ? (size_t)x : PLATO_TABLE_TILT_SIZE - 2;
+    size_t j = (y < PLATO_TABLE_TEMPERATURE_SIZE - 1) ? (size_t)y : PLATO_TABLE_TEMPERATURE_SIZE - 2;
+
+    if (!check(i, j))
+        return false;
+
+    *plato = interpolate(i, j, x - i, y - j);
+    return true;
+}
+
+float PlatoTable::get_error_max() const
+{
+    return this->error_max;
+}
+
+float PlatoTable::calculate(const float (&coefficients)[5], float tilt, float temperature)
+{
+    /* Gravity calculated using the formula: a*tilt^4 + b*tilt^3 + c*tilt^2 + d*tilt + e */
+    float gravity = polynomial_evaluate(coefficients, tilt);
+
+    /* Gravity correction depending on the temperature, if temperature read ok. */
+    if (temperature != PLATO_TABLE_TEMPERATURE_ERROR)
+        gravity *= gravity_temperature_correction((temperature * 1.8f) + 32);
+
+    /* Fixed point error stays below 0.002 °P, under the 0.01 °P resolution of the stored measurement. */
+    return (float)plato_from_gravity(q16_16(gravity));
+}
+
+int16_t PlatoTable::value(size_t i, size_t j)
+{
+    if (this->values[i][j] == PLATO_TABLE_EMPTY)
+    {
+        float plato = calculate(this->coefficients, PLATO_TABLE_TILT_MIN + i * PLATO_TABLE_TILT_STEP,
+                                PLATO_TABLE_TEMPERATURE_MIN + j * PLATO_TABLE_TEMPERATURE_STEP) * PLATO_TABLE_SCALE;
+
+        /* PLATO_TABLE_EMPTY itself is never stored. */
+        this->values[i][j] = (plato > INT16_MAX) ? INT16_MAX : (plato < INT16_MIN + 1) ? INT16_MIN + 1 : (int16_t)lroundf(plato);
+    }
+
+    return this->values[i][j];
+}
+
+float PlatoTable::interpolate(size_t i, size_t j, float u, float v)
+{
+    return ((1 - u) * ((1 - v) * value(i, j)     + v * value(i, j + 1)) +
+                 u  * ((1 - v) * value(i + 1, j) + v * value(i + 1, j + 1))) / PLATO_TABLE_SCALE;
+}
+
+bool PlatoTable::check(size_t i, size_t j)
+{
+    /* Middle of the cell and of its edges, as fractions of the cell. */
+    static const float points[][2] = {{0.5f, 0.5f}, {0.5f, 0}, {0.5f, 1}, {0, 0.5f}, {1, 0.5f}};
+
+    if (this->cells[i][j] == PLATO_TABLE_CELL_UNCHECKED)
+    {
+        /* Rounding of the stored values shows only partly at the checked points. */
+        float error = 0.5f / PLATO_TABLE_SCALE;
+
+        for (size_t k = 0; k < sizeof(points) / sizeof(points[0]); k++)
+        {
+            float exact = calculate(this->coefficients, PLATO_TABLE_TILT_MIN + (i + points[k][0]) * PLATO_TABLE_TILT_STEP,
+                                    PLATO_TABLE_TEMPERATURE_MIN + (j + points[k][1]) * PLATO_TABLE_TEMPERATURE_STEP);
+
+            error = fmaxf(error, fabsf(interpolate(i, j, points[k][0], points[k][1]) - exact) + 0.5f / PLATO_TABLE_SCALE);
+        }
+
+        this->cells[i][j] = (error <= PLATO_TABLE_ERROR_MAX) ? PLATO_TABLE_CELL_FINE : PLATO_TABLE_CELL_COARSE;
+        this->error_max = fmaxf(this->error_max, error);
+    }
+
+    return this->cells[i][j] == PLATO_TABLE_CELL_FINE;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file profiler.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <Esp.h>
+#include <profiler.h>
+#include <rtc_memory.h>
+#include <log_debug.h>
+
+//--------------------------------------------------------------------------------
+/* Private variables and types. */
+
+/** @brief Names of the phases, in the order of profiler_phase. */
+static const char *profiler_phase_names[PROFILER_PHASE_COUNT] =
+{
+    "battery", "config", "wifi", "auth", "temperature", "tilt", "flash", "upload", "sleep"
+};
+
+/** @brief Current draw of the phases in mA, in the order of profiler_phase. */
+static const uint16_t profiler_currents[PROFILER_PHASE_COUNT] =
+{
+    PROFILER_CURRENT_BATTERY, PROFILER_CURRENT_CONFIG, PROFILER_CURRENT_WIFI,
+    PROFILER_CURRENT_AUTH, PROFILER_CURRENT_TEMPERATURE, PROFILER_CURRENT_TILT,
+    PROFILER_CURRENT_FLASH, PROFILER_CURRENT_UPLOAD, PROFILER_CURRENT_SLEEP
+};
+
+//--------------------------------------------------------------------------------
+
+Profiler& Profiler::get_instance()
+{
+    return instance;
+}
+
+void Profiler::init()
+{
+    memset(this->cycles, 0, sizeof(this->cycles));
+    this->depth = 0;
+
+    if (!rtc_memory_read(RTC_SLOT_PROFILER, &this->summary, sizeof(this->summary)) ||
+        this->summary.wakes >= PROFILER_SUMMARY_WAKES_MAX)
+    {
+        clear_summary();
+    }
+}
+
+void Profiler::begin(profiler_phase phase)
+{
+    if (this->depth >= PROFILER_DEPTH_MAX)
+        return;
+
+    /* The enclosing span is paused, its time so far is added now. */
+    if (this->depth > 0)
+        account();
+
+    this->stack[this->depth++] = phase;
+    this->start = ESP.getCycleCount();
+}
+
+void Profiler::end()
+{
+    if (this->depth == 0)
+        return;
+
+    account();
+    this->depth--;
+}
+
+void Profiler::save()
+{
+    uint32_t awake = millis();
+
+    this->summary.wakes++;
+    this->summary.awake += awake;
+
+    for (size_t i = 0; i < PROFILER_PHASE_COUNT; i++)
+    {
+        uint32_t time = get_time((profiler_phase)i);
+
+        this->summary.time[i] += (time + 500) / 1000;
+        LOG("[PROFILER] " + String(get_phase_name((profiler_phase)i)) + ": " + String(time) + " us, " +
+            String(get_charge((profiler_phase)i, time), 2) + " uAh");
+    }
+
+    LOG("[PROFILER] Awake: " + String(awake) + " ms, summarized wake-ups: " + String(this->summary.wakes));
+    rtc_memory_write(RTC_SLOT_PROFILER, &this->summary, sizeof(this->summary));
+}
+
+bool Profiler::is_summary_due()
+{
+    return this->summary.wakes >= PROFILER_SUMMARY_WAKES;
+}
+
+const profiler_rtc &Profiler::get_summary()
+{
+    return this->summary;
+}
+
+void Profiler::clear_summary()
+{
+    memset(&this->summary, 0, sizeof(this->summary));
+}
+
+uint32_t Profiler::get_time(profiler_phase phase)
+{
+    return (uint32_t)(this->cycles[phase] / ESP.getCpuFreqMHz());
+}
+
+float Profiler::get_charge(profiler_phase phase, uint32_t time)
+{
+    /* mA * us = 1 / 3.6e6 uAh */
+    return (float)profiler_currents[phase] * time / 3600000.0f;
+}
+
+const char *Profiler::get_phase_name(profiler_phase phase)
+{
+    return profiler_phase_names[phase];
+}
+
+void Profiler::account()
+{
+    uint32_t now = ESP.getCycleCount();
+
+    /* Unsigned subtraction handles a single wrap of the counter. */
+    this->cycles[this->stack[this->depth - 1]] += (uint32_t)(now - this->start);
+    this->start = now;
+}
+
+Profiler Profiler::instance;
@@ -0,0 +1,49 @@
+/**
+ * @file rtc_memory.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <rtc_memory.h>
+
+//--------------------------------------------------------------------------------
+/* Private variables. */
+
+/** @brief Word aligned buffer, RTC memory is accessed in 4-byte blocks. */
+static uint32_t rtc_buf[RTC_MEMORY_SIZE / sizeof(uint32_t)];
+
+//--------------------------------------------------------------------------------
+
+bool rtc_memory_read(rtc_memory_slot slot, void *data, size_t size)
+{
+    size_t blocks = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    if ((slot + blocks + 1) * sizeof(uint32_t) > RTC_MEMORY_SIZE)
+        return false;
+
+    if (!ESP.rtcUserMemoryRead(slot, rtc_buf, (blocks + 1) * sizeof(uint32_t)))
+        return false;
+
+    if (rtc_buf[blocks] != crc32(rtc_buf, size))
+        return false;
+
+    memcpy(data, rtc_buf, size);
+    return true;
+}
+
+bool rtc_memory_write(rtc_memory_slot slot, const void *data, size_t size)
+{
+    size_t blocks = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    if ((slot + blocks + 1) * sizeof(uint32_t) > RTC_MEMORY_SIZE)
+        return false;
+
+    memset(rtc_buf, 0, blocks * sizeof(uint32_t));
+    memcpy(rtc_buf, data, size);
+    rtc_buf[blocks] = crc32(rtc_buf, size);
+
+    return ESP.rtcUserMemoryWrite(slot, rtc_buf, (blocks + 1) * sizeof(uint32_t));
+}
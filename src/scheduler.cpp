@@ -0,0 +1,37 @@
+/**
+ * @file scheduler.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <scheduler.h>
+
+//--------------------------------------------------------------------------------
+
+uint64_t scheduler_sleep(uint64_t now, uint64_t sleep_time, uint32_t seed, uint8_t failures, uint32_t random)
+{
+    uint64_t sleep = sleep_time;
+
+    /* On the grid the long-run interval does not depend on the awake time, the clock follows NTP. */
+    if ((now != 0) && (sleep_time > 0))
+    {
+        uint64_t offset = seed % std::min<uint64_t>(SCHEDULER_JITTER_MAX, sleep_time);
+        uint64_t next = (now + SCHEDULER_SLEEP_MIN - offset + sleep_time - 1) / sleep_time * sleep_time + offset;
+
+        sleep = next - now;
+    }
+
+    /* Full jitter, devices failing together after an outage retry spread over the window. */
+    if (failures > 0)
+    {
+        uint64_t window = std::min<uint64_t>(SCHEDULER_BACKOFF_BASE << std::min(failures - 1, SCHEDULER_BACKOFF_EXP_MAX), sleep_time);
+
+        sleep += (uint64_t)(random % (uint32_t)(window / 1000 + 1)) * 1000;
+    }
+
+    return sleep;
+}
@@ -11,12 +11,22 @@
 
 //--------------------------------------------------------------------------------
 
+static String generate_push_key(uint64_t time_ms);
+static String generate_untimed_key();
+static bool is_token_rejected();
+
+//--------------------------------------------------------------------------------
+
 Sender::Sender()
 {
     database = new FB_RTDB;
     fbdo = new FirebaseData;
     auth = new FirebaseAuth;
     fb_config = new FirebaseConfig;
+    data_log = new DataLog;
+    data_staging = new DataStaging;
+    handshake_count = 0;
+    handshake_time = 0;
 #if LOG_DEBUG == LOG_WIFI
     is_path = false;
 #endif
@@ -28,6 +38,8 @@ Sender::~Sender()
     delete fbdo;
     delete auth;
     delete fb_config;
+    delete data_log;
+    delete data_staging;
 #if LOG_DEBUG == LOG_WIFI
     if (log_buf != nullptr)
         delete log_buf;
@@ -56,28 +68,44 @@ void Sender::init()
     config.get(DATABASE_URL, this->database_url);
 
     fb_config->api_key = this->api_key;
-    auth->user.email = this->email;
-    auth->user.password = this->password;
     fb_config->database_url = this->database_url;
     fbdo->setResponseSize(4096);
-    Firebase.RTDB.setMaxRetry(fbdo, 5);
+    /* Failed batches are retried by send_batch_retry(), within the upload time budget. */
+    Firebase.RTDB.setMaxRetry(fbdo, 1);
     Firebase.reconnectWiFi(true);
-    Firebase.begin(fb_config, auth);
 
-    unsigned long ms = millis();
-    while ((auth->token.uid) == "") 
+    String uid;
+    if (load_token(uid))
     {
-        delay(300);
-        if (millis() - ms >= 5000)
+        /* The token is refreshed by Firebase.ready() when it expires, sign-in is not needed. */
+        Firebase.begin(fb_config, auth);
+        LOG("[SENDER] Cached auth token used.");
+    }
+    else
+    {
+        auth->user.email = this->email;
+        auth->user.password = this->password;
+        Firebase.begin(fb_config, auth);
+
+        unsigned long ms = millis();
+        while ((auth->token.uid) == "") 
         {
-            LOG("[SENDER] Getting User UID timeout!");
-            initialized = false;
-            return;
+            delay(300);
+            if (millis() - ms >= 5000)
+            {
+                LOG("[SENDER] Getting User UID timeout!");
+                initialized = false;
+                return;
+            }
         }
+
+        uid = auth->token.uid.c_str();
+        save_token(uid, get_time_since_epoch() + SENDER_TOKEN_LIFETIME);
     }
 
-    String uid = auth->token.uid.c_str();
+    this->token_uid = uid;
     this->database_path = "UsersData/" + uid + "/readings";
+    this->profile_path = "UsersData/" + uid + "/profile";
 #if LOG_DEBUG == LOG_WIFI
     this->log_path = "UsersData/" + uid + "/logs/";
 #endif
@@ -85,193 +113,340 @@ void Sender::init()
     LOG("[SENDER] Firebase sender : successful initialization.");
 }
 
-void Sender::send_data(data *measurement)
+bool Sender::send_data(data *measurement)
 {
-    ConfigManager& config = ConfigManager::get_instance();
-    bool status = true;
+    /* Staged measurements are older than the current one, they go through the log to keep the order. */
+    this->flush_staging();
 
-    if(data_waiting_to_sent())
-    {
-        std::vector <data> data_vector;
-        uint64_t time_interval;
-        time_t time;
-
-        this->parse_data_files(&data_vector);
-        config.get(SLEEP_TIME, &time_interval);
-        time = get_time_since_epoch();
-        
-        /* If there is a time read error, do not calculate the time, but send the error value. */
-        time += time == TIME_ERROR ? 0 : - ((time_interval / 1000000) * (data_vector.size()));
-
-        for (data it : data_vector)
-        {
-            status &= this->send_temperature(it.temperature)         &&
-                      this->send_battery_voltage(it.battery_voltage) &&
-                      this->send_plato(it.plato)                     &&
-                      this->send_time(time);
+    data records[SENDER_BATCH_RECORDS_MAX];
+    uint32_t backlog_size = this->data_log->count();
+    uint32_t sent;
+    upload_link link = {this, millis()};
+    bool measurement_sent = sender_upload(link, records, SENDER_BATCH_RECORDS_MAX, measurement, &sent);
 
-            time == TIME_ERROR ? 0 : time += (time_interval / 1000000);
-        }
+    if (link.elapsed() >= SENDER_UPLOAD_TIME_BUDGET)
+    {
+        LOG("[SENDER] Upload time budget exceeded!");
     }
 
-    status &= this->send_temperature(measurement->temperature)          &&
-              this->send_battery_voltage(measurement->battery_voltage)  &&
-              this->send_plato(measurement->plato)                      &&
-              this->send_time();
+    /* A token refreshed during the upload is saved for the next wake-up. */
+    if (this->initialized && (crc32(Firebase.getToken(), strlen(Firebase.getToken())) != this->token_crc))
+        save_token(this->token_uid, get_time_since_epoch() + SENDER_TOKEN_LIFETIME);
 
-    LOG("[SENDER] Data sent" + String(status ? " successfully." : " unsuccessfully."));
-}
-
-bool Sender::data_waiting_to_sent()
-{
-    return LittleFS.exists("/data/0.txt");
+    LOG("[SENDER] Data sent: " + String(sent) + "/" + String(backlog_size + (measurement != nullptr)) + " measurements.");
+    LOG("[SENDER] TLS handshakes: " + String(this->handshake_count) + ", " + String(this->handshake_time) + " ms");
+    return measurement_sent;
 }
 
 void Sender::save_data(data &measurement)
 {
-    char file_path[16];
-    uint32_t number_of_files = 0;
-    Dir dir = LittleFS.openDir("/data");
+    if (this->data_staging->append(measurement))
+        return;
 
-    while(dir.next())
-        number_of_files++;
+    /* Staging buffer full, it is moved to flash and the measurement starts a new one. */
+    if (this->flush_staging() && this->data_staging->append(measurement))
+        return;
 
-    if (number_of_files >= SENDER_DATA_FILES_MAX)
+    if (!this->data_log->append(measurement))
     {
-        Serial.println("[SENDER] Max files");
-        return;
+        LOG("[SENDER] Measurement could not be saved!");
     }
-
-    sprintf(file_path, "/data/%hd.txt", number_of_files);
-
-    File data_file = LittleFS.open(file_path, "w");
-    data_file.write((byte *)&measurement, sizeof(measurement));
-    data_file.close();
 }
 
-void Sender::parse_data_files(std::vector <data> *data_vector)
+bool Sender::flush_staging()
 {
-    data temp;
-    Dir dir = LittleFS.openDir("/data");
-    
-    while(dir.next())
+    data records[DATA_STAGING_RECORDS_MAX];
+    size_t count = this->data_staging->read(records, DATA_STAGING_RECORDS_MAX);
+
+    if (count == 0)
+        return true;
+
+    Profiler::get_instance().begin(PROFILER_PHASE_FLASH);
+    bool status = this->data_log->append(records, count);
+    Profiler::get_instance().end();
+
+    if (!status)
     {
-        File data_file = dir.openFile("r");
-        data_file.read((byte *)&temp, sizeof(temp));
-        data_vector->push_back(temp);
-        data_file.close();
-        LittleFS.remove("/data/" + String(dir.fileName()));
+        LOG("[SENDER] Staged measurements could not be saved!");
+        return false;
     }
+
+    this->data_staging->clear();
+    return true;
 }
 
-bool Sender::send_temperature(float temperature)
+bool Sender::send_batch(const data *records, size_t count)
 {
+    FirebaseJson json;
+
     if (!this->initialized)
         init();
 
     if (!Firebase.ready())
     {
+        /* A revoked token makes the next wake-up sign in again, after a network error it is kept. */
+        if (is_token_rejected())
+        {
+            LittleFS.remove(SENDER_TOKEN_PATH);
+            LOG("[SENDER] Cached auth token rejected.");
+        }
+
         LOG("[SENDER] Firebase is not ready!");
         return false;
     }
 
-    this->parent_path = this->database_path + "/temperature";
-    if (database->pushFloatAsync(fbdo, parent_path, temperature))
-        return true;
-    else
+    /* One multi-path update, every measurement gets the same key in all subpaths and on every attempt. */
+    for (size_t i = 0; i < count; i++)
     {
-        LOG("[SENDER] Temperature send failed, reason: " + fbdo->errorReason());
-        return false;
+        char key[SENDER_KEY_BUF_SIZE];
+
+        sender_record_key(records[i], ESP.getChipId(), records[i].time != TIME_ERROR, key);
+        sender_batch_add(json, key, records[i], records[i].time != TIME_ERROR);
     }
-}
 
-bool Sender::send_plato(float plato)
-{
-    if (!this->initialized)
-        init();
+    /* All batches share the keep-alive connection of fbdo, only the first one pays for the handshake. */
+    bool connected = fbdo->httpConnected();
+    unsigned long ms = millis();
+    bool status = database->updateNodeSilent(fbdo, database_path, &json);
 
-    if (!Firebase.ready())
+    if (!connected)
     {
-        LOG("[SENDER] Firebase is not ready!");
-        return false;
+        this->handshake_count++;
+        this->handshake_time += millis() - ms;
     }
 
-    this->parent_path = this->database_path + "/plato";
-    if (database->pushFloatAsync(fbdo, parent_path, plato))
+    if (status)
         return true;
-    else
+
+    LOG("[SENDER] Batch send failed, reason: " + fbdo->errorReason());
+    return false;
+}
+
+uint32_t Sender::upload_link::count()
+{
+    return this->sender->data_log->count();
+}
+
+size_t Sender::upload_link::read(data *records, size_t max)
+{
+    Profiler::get_instance().begin(PROFILER_PHASE_FLASH);
+    size_t count = this->sender->data_log->read(records, max);
+    Profiler::get_instance().end();
+
+    if ((count == 0) && (this->sender->data_log->count() > 0))
     {
-        LOG("[SENDER] Plato send failed, reason: " + fbdo->errorReason());
-        return false;
+        LOG("[SENDER] Saved measurements could not be read!");
     }
+
+    return count;
+}
+
+void Sender::upload_link::drop(size_t count)
+{
+    /* Only acknowledged measurements are removed, the rest waits for the next wake-up. */
+    Profiler::get_instance().begin(PROFILER_PHASE_FLASH);
+    this->sender->data_log->drop(count);
+    Profiler::get_instance().end();
+}
+
+void Sender::upload_link::save(const data &measurement)
+{
+    data record = measurement;
+    this->sender->save_data(record);
+}
+
+bool Sender::upload_link::send(const data *records, size_t count)
+{
+    return this->sender->send_batch(records, count);
+}
+
+uint32_t Sender::upload_link::elapsed()
+{
+    return millis() - this->start;
+}
+
+void Sender::upload_link::retry(int attempt)
+{
+    LOG("[SENDER] Batch send retry: " + String(attempt));
+}
+
+uint32_t Sender::get_handshake_count()
+{
+    return this->handshake_count;
+}
+
+uint32_t Sender::get_handshake_time()
+{
+    return this->handshake_time;
 }
 
-bool Sender::send_time(time_t time)
+bool Sender::send_profile(const profiler_rtc &summary)
 {
-    if (time == 0)
+    FirebaseJson json;
+
+    if (!this->initialized || (summary.wakes == 0) || !Firebase.ready())
         return false;
 
-    if (!this->initialized)
-        init();
+    uint32_t now = get_time_since_epoch();
+    String path = ((now == TIME_ERROR) ? generate_untimed_key() : generate_push_key((uint64_t)now * 1000)) + "/";
 
-    if (!Firebase.ready())
+    json.add(path + "wakes", (int)summary.wakes);
+    json.add(path + "awake", (float)summary.awake / summary.wakes);
+
+    if (now != TIME_ERROR)
+        json.add(path + "time", (int)now);
+
+    for (size_t i = 0; i < PROFILER_PHASE_COUNT; i++)
     {
-        LOG("[SENDER] Firebase is not ready!");
-        return false;
+        profiler_phase phase = (profiler_phase)i;
+        float time = (float)summary.time[i] / summary.wakes;
+
+        json.add(path + "time_ms/" + Profiler::get_phase_name(phase), time);
+        json.add(path + "charge_uah/" + Profiler::get_phase_name(phase), Profiler::get_charge(phase, (uint32_t)(time * 1000)));
     }
-        
-    this->parent_path = this->database_path + "/time";
-    if (database->pushFloatAsync(fbdo, parent_path, time))
+
+    if (database->updateNodeSilent(fbdo, profile_path, &json))
         return true;
-    else
-    {
-        LOG("[SENDER] Time send failed, reason: " + fbdo->errorReason());
-        return false;
-    }
+
+    LOG("[SENDER] Profile send failed, reason: " + fbdo->errorReason());
+    return false;
 }
 
-bool Sender::send_time()
+bool Sender::load_token(String &uid)
 {
-    if (!this->initialized)
-        init();
+    sender_token_header header;
+    uint32_t now = get_time_since_epoch();
+    bool valid;
 
-    if (!Firebase.ready())
+    /* Without time the token expiry cannot be checked. */
+    if ((now == TIME_ERROR) || !LittleFS.begin())
+        return false;
+
+    File file = LittleFS.open(SENDER_TOKEN_PATH, "r");
+    if (!file)
+        return false;
+
+    valid = (file.read((uint8_t *)&header, sizeof(header)) == sizeof(header)) &&
+            (header.magic == SENDER_TOKEN_MAGIC)                               &&
+            (header.id_size < SENDER_TOKEN_ID_MAX)                             &&
+            (header.refresh_size < SENDER_TOKEN_REFRESH_MAX)                   &&
+            (header.uid_size < SENDER_TOKEN_UID_MAX)                           &&
+            (header.refresh_size > 0);
+    if (!valid)
     {
-        LOG("[SENDER] Firebase is not ready!");
+        file.close();
         return false;
     }
 
-    time_t time = get_time_since_epoch();
+    char *buf = new char[header.id_size + header.refresh_size + header.uid_size + 3];
+    char *id_token = buf;
+    char *refresh_token = id_token + header.id_size + 1;
+    char *token_uid = refresh_token + header.refresh_size + 1;
 
-    this->parent_path = this->database_path + "/time";
-    if (database->pushIntAsync(fbdo, parent_path, time))
-        return true;
-    else
+    valid = (file.read((uint8_t *)id_token, header.id_size) == header.id_size)                &&
+            (file.read((uint8_t *)refresh_token, header.refresh_size) == header.refresh_size) &&
+            (file.read((uint8_t *)token_uid, header.uid_size) == header.uid_size);
+    file.close();
+
+    id_token[header.id_size] = '\0';
+    refresh_token[header.refresh_size] = '\0';
+    token_uid[header.uid_size] = '\0';
+
+    if (valid)
     {
-        LOG("[SENDER] Time send failed, reason: " + fbdo->errorReason());
-        return false;
+        uint32_t crc = crc32(&header, offsetof(sender_token_header, crc));
+        crc = crc32(id_token, header.id_size, crc);
+        crc = crc32(refresh_token, header.refresh_size, crc);
+        valid = (header.crc == crc32(token_uid, header.uid_size, crc));
+    }
+
+    if (valid)
+    {
+        /* Near expiry the token is passed as expired, Firebase exchanges the refresh token for a new one. */
+        Firebase.setIdToken(fb_config, id_token, sender_token_remaining(now, header.expires), refresh_token);
+        this->token_crc = crc32(id_token, header.id_size);
+        uid = token_uid;
     }
+
+    delete[] buf;
+    return valid;
 }
 
-bool Sender::send_battery_voltage(float voltage)
+void Sender::save_token(const String &uid, uint32_t expires)
 {
-    if (!this->initialized)
-        init();
+    sender_token_header header;
+    const char *id_token = Firebase.getToken();
+    const char *refresh_token = Firebase.getRefreshToken();
 
-    if (!Firebase.ready())
-    {
-        LOG("[SENDER] Firebase is not ready!");
-        return false;
-    }
+    header.magic = SENDER_TOKEN_MAGIC;
+    header.expires = expires;
+    header.id_size = strlen(id_token);
+    header.refresh_size = strlen(refresh_token);
+    header.uid_size = uid.length();
+    header.reserved = 0;
 
-    parent_path = database_path + "/voltage";
-    if (database->pushFloatAsync(fbdo, parent_path, voltage))
-        return true;
-    else
+    this->token_crc = crc32(id_token, header.id_size);
+
+    if ((expires <= SENDER_TOKEN_LIFETIME) || (header.id_size >= SENDER_TOKEN_ID_MAX) ||
+        (header.refresh_size >= SENDER_TOKEN_REFRESH_MAX) || (header.uid_size >= SENDER_TOKEN_UID_MAX))
+        return;
+
+    uint32_t crc = crc32(&header, offsetof(sender_token_header, crc));
+    crc = crc32(id_token, header.id_size, crc);
+    crc = crc32(refresh_token, header.refresh_size, crc);
+    header.crc = crc32(uid.c_str(), header.uid_size, crc);
+
+    Profiler::get_instance().begin(PROFILER_PHASE_FLASH);
+
+    File file = LittleFS.open(SENDER_TOKEN_PATH, "w");
+    if (!file)
     {
-        LOG("[SENDER] Voltage send failed, reason: " + fbdo->errorReason());
-        return false;
+        Profiler::get_instance().end();
+        LOG("[SENDER] Auth token could not be saved!");
+        return;
     }
+
+    file.write((uint8_t *)&header, sizeof(header));
+    file.write((const uint8_t *)id_token, header.id_size);
+    file.write((const uint8_t *)refresh_token, header.refresh_size);
+    file.write((const uint8_t *)uid.c_str(), header.uid_size);
+    file.close();
+
+    Profiler::get_instance().end();
+}
+
+/**
+ * @brief Generates a chronologically ordered key in the same format as Firebase push().
+ * @param [in] time_ms - Time in milliseconds encoded in the key prefix
+ * @return String - 20 characters long key
+ */
+static String generate_push_key(uint64_t time_ms)
+{
+    char key[SENDER_PUSH_KEY_SIZE + 1];
+
+    sender_push_key(time_ms, random, key);
+    return String(key);
+}
+
+/**
+ * @brief Generates a key for a profile summary sent without time, the prefix keeps it apart from the timed keys.
+ *        Measurements get their keys from sender_record_key() instead.
+ * @return String - key prefixed with SENDER_UNTIMED_KEY_PREFIX
+ */
+static String generate_untimed_key()
+{
+    return SENDER_UNTIMED_KEY_PREFIX + generate_push_key(0);
+}
+
+/**
+ * @brief Checks whether the auth server rejected the token of the last auth request, @see sender_token_rejected().
+ * @return true if the token was rejected, otherwise false
+ */
+static bool is_token_rejected()
+{
+    TokenInfo info = Firebase.authTokenInfo();
+
+    return (info.status == token_status_error) && sender_token_rejected(info.error.code);
 }
 
 #if LOG_DEBUG == LOG_WIFI
@@ -0,0 +1,112 @@
+/**
+ * @file sender_protocol.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <sender_protocol.h>
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+/** @brief Characters of the push keys, in the order of their ASCII codes. */
+static const char push_key_chars[] = "-0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz";
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static void write_key_prefix(uint64_t time_ms, char *key);
+static uint64_t hash_word(uint64_t hash, uint32_t word);
+
+//--------------------------------------------------------------------------------
+
+void sender_push_key(uint64_t time_ms, long (*random)(long), char *key)
+{
+    write_key_prefix(time_ms, key);
+
+    for (int i = 8; i < SENDER_PUSH_KEY_SIZE; i++)
+        key[i] = push_key_chars[random(64)];
+
+    key[SENDER_PUSH_KEY_SIZE] = '\0';
+}
+
+void sender_record_key(const data &measurement, uint32_t device_id, bool timed, char *key)
+{
+    measurement_fixed fixed = MeasurementCodec::to_fixed(measurement);
+    uint64_t hash = 0xCBF29CE484222325ULL;
+
+    hash = hash_word(hash, device_id);
+    hash = hash_word(hash, fixed.time);
+    hash = hash_word(hash, (uint32_t)fixed.temperature);
+    hash = hash_word(hash, (uint32_t)fixed.plato);
+    hash = hash_word(hash, (uint32_t)fixed.voltage);
+    hash = hash_word(hash, fixed.sequence);
+
+    /* FNV multiplication carries only to the higher bits, the MurmurHash3 finalizer mixes them back down. */
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+
+    if (!timed)
+    {
+        for (size_t i = 0; i < sizeof(SENDER_UNTIMED_KEY_PREFIX) - 1; i++)
+            *key++ = SENDER_UNTIMED_KEY_PREFIX[i];
+    }
+
+    write_key_prefix(timed ? (uint64_t)fixed.time * 1000 : fixed.sequence, key);
+
+    /* 12 characters take 72 bits, the hash is rotated so its bits are spread over all of them. */
+    for (int i = 8; i < SENDER_PUSH_KEY_SIZE; i++)
+    {
+        key[i] = push_key_chars[hash % 64];
+        hash = (hash >> 6) | (hash << 58);
+    }
+
+    key[SENDER_PUSH_KEY_SIZE] = '\0';
+}
+
+uint32_t sender_token_remaining(uint32_t now, uint32_t expires)
+{
+    return (expires > now + SENDER_TOKEN_MARGIN) ? expires - now : 0;
+}
+
+bool sender_token_rejected(int code)
+{
+    return (code >= 400) && (code < 500);
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Writes the time as the 8 characters of the key prefix, the keys sort chronologically.
+ * @param [in] time_ms - Time in milliseconds
+ * @param [out] key - Key, its first 8 characters are written
+ */
+static void write_key_prefix(uint64_t time_ms, char *key)
+{
+    for (int i = 7; i >= 0; i--)
+    {
+        key[i] = push_key_chars[time_ms % 64];
+        time_ms /= 64;
+    }
+}
+
+/**
+ * @brief Adds the word to the FNV-1a hash, byte by byte from the lowest one, the same on every platform.
+ * @param [in] hash - Hash of the previous words
+ * @param [in] word - Word to add
+ * @return uint64_t - Hash including the word
+ */
+static uint64_t hash_word(uint64_t hash, uint32_t word)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        hash ^= (word >> (8 * i)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
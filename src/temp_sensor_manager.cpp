@@ -19,6 +19,7 @@ Temperature::Temperature()
     one_wire = new OneWire();
     temp_sensor = new DallasTemperature(one_wire);
     initialized = false;
+    resolution = DS18B20_RESOLUTION;
 }
 
 Temperature::~Temperature()
@@ -30,11 +31,17 @@ Temperature::~Temperature()
 void Temperature::init(uint8_t pin)
 {
     one_wire->begin(pin);
-    temp_sensor->begin();
-    initialized = temp_sensor->getAddress(&this->device_address, 0);
-    initialized &= temp_sensor->setResolution(&this->device_address, DS18B20_RESOLUTION, false);
-    temp_sensor->setWaitForConversion(true);
-    initialized &= temp_sensor->requestTemperaturesByAddress(&this->device_address);
+
+    /* Resolution changes are kept in the scratchpad only, without EEPROM writes. */
+    temp_sensor->setAutoSaveScratchPad(false);
+
+    /* The bus is searched only on the first wake-up or when the cached sensor does not respond. */
+    initialized = rtc_memory_read(RTC_SLOT_TEMP_SENSOR, &cache, sizeof(cache)) && temp_sensor->validFamily(cache.address);
+    if (initialized)
+        initialized = start_conversion();
+
+    if (!initialized)
+        initialized = find_sensor() && start_conversion();
 
     LOG("[TEMP_SENSOR_MANAGER] DS18B20 Sensor initialization : " + String(this->initialized ? " successful" : " failed"));
 }
@@ -47,8 +54,12 @@ float Temperature::get_temp()
         return -127;
     }
     
-    temp_sensor->requestTemperaturesByIndex(0);
-    float temp = temp_sensor->getTempCByIndex(0);
+    /* A parasite powered sensor cannot signal the end of conversion, only the deadline is used. */
+    while ((millis() - conversion_start < (unsigned long)(conversion_time + DS18B20_CONVERSION_MARGIN)) &&
+           (cache.parasite || !temp_sensor->isConversionComplete()))
+        yield();
+
+    float temp = temp_sensor->getTempC(cache.address);
 
     if (temp == -85)
     {
@@ -58,15 +69,81 @@ float Temperature::get_temp()
 
     if (temp == DEVICE_DISCONNECTED_C)
     {
+        /* Presence or CRC check failed, the next wake-up searches the bus again. */
+        memset(&cache, 0, sizeof(cache));
+        rtc_memory_write(RTC_SLOT_TEMP_SENSOR, &cache, sizeof(cache));
         LOG("[TEMP_SENSOR_MANAGER] Temperature sensor disconnected!");
         return temp;
     }
 
-    LOG("[TEMP_SENSOR_MANAGER] Temperature read :" + String(temp + TEMPERATURE_OFFSET));
+    save_reading(temp);
+    LOG("[TEMP_SENSOR_MANAGER] Temperature read :" + String(temp + TEMPERATURE_OFFSET) + ", resolution: " + String(resolution));
 
     return (temp + TEMPERATURE_OFFSET);
 }
 
+bool Temperature::find_sensor()
+{
+    memset(&cache, 0, sizeof(cache));
+
+    temp_sensor->begin();
+    if (!temp_sensor->getAddress(cache.address, 0))
+        return false;
+
+    cache.parasite = temp_sensor->isParasitePowerMode();
+    rtc_memory_write(RTC_SLOT_TEMP_SENSOR, &cache, sizeof(cache));
+
+    LOG("[TEMP_SENSOR_MANAGER] DS18B20 Sensor found on the bus.");
+    return true;
+}
+
+bool Temperature::start_conversion()
+{
+    /* The scratchpad is read and checked with CRC, the configuration is written only when it differs. */
+    resolution = select_resolution();
+    if (!temp_sensor->setResolution(cache.address, resolution, true))
+        return false;
+
+    one_wire->reset();
+    one_wire->select(cache.address);
+    one_wire->write(DS18B20_CONVERT_T, cache.parasite);
+
+    conversion_start = millis();
+    conversion_time = DallasTemperature::millisToWaitForConversion(resolution);
+    return true;
+}
+
+uint8_t Temperature::select_resolution()
+{
+    if (cache.history_count < DS18B20_HISTORY_SIZE)
+        return DS18B20_RESOLUTION;
+
+    int16_t min = cache.history[0];
+    int16_t max = cache.history[0];
+    for (int i = 1; i < DS18B20_HISTORY_SIZE; i++)
+    {
+        min = std::min(min, cache.history[i]);
+        max = std::max(max, cache.history[i]);
+    }
+
+    float last = (cache.history[0] / 16.0) + TEMPERATURE_OFFSET;
+    bool stable = ((max - min) / 16.0) <= DS18B20_STABLE_THRESHOLD;
+    bool in_band = (last >= TEMPERATURE_ALARM_LOW + TEMPERATURE_ALARM_MARGIN) &&
+                   (last <= TEMPERATURE_ALARM_HIGH - TEMPERATURE_ALARM_MARGIN);
+
+    return (stable && in_band) ? DS18B20_RESOLUTION_LOW : DS18B20_RESOLUTION;
+}
+
+void Temperature::save_reading(float temp)
+{
+    for (int i = DS18B20_HISTORY_SIZE - 1; i > 0; i--)
+        cache.history[i] = cache.history[i - 1];
+
+    cache.history[0] = (int16_t)lroundf(temp * 16);
+    cache.history_count = std::min(cache.history_count + 1, DS18B20_HISTORY_SIZE);
+    rtc_memory_write(RTC_SLOT_TEMP_SENSOR, &cache, sizeof(cache));
+}
+
 void Temperature::sleep()
 {
     this->one_wire->depower();
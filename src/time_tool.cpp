@@ -1,4 +1,3 @@
-
 /**
  * @file time_tool.cpp
  * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
@@ -14,35 +13,41 @@
 #define UTC_OFFSET_SEC 3600L
 
 //--------------------------------------------------------------------------------
-/* Private variables. */
+/* Private variables and types. */
+
+/** @brief Clock kept in the RTC memory across deep sleep. */
+struct rtc_clock
+{
+    uint64_t boot_time_us;  /**< Time since epoch at the device wake-up, in microseconds. */
+    uint32_t ntp_time;      /**< Time since epoch of the last NTP synchronization. */
+    int32_t drift;          /**< Drift of the deep sleep timer, in ppm, positive when it sleeps longer than requested. */
+};
 
 static WiFiUDP ntpUDP;
 static NTPClient time_client(ntpUDP, "pool.ntp.org", UTC_OFFSET_SEC);
-static time_t time_since_epoch;
-static time_t start_time;
+static rtc_clock device_clock;
 static char time_buff[32];
 static bool initialized = false;
+static bool synchronized = false;
 
 //--------------------------------------------------------------------------------
 /* Private function declatarions. */
 
 static bool begin_time();
+static bool synchronize_time();
+static void measure_drift(const rtc_clock &predicted);
 
 //--------------------------------------------------------------------------------
 
 char* get_utc_time()
 {
-    if (!initialized)
+    time_t time_since_epoch = get_time_since_epoch();
+    if (time_since_epoch == TIME_ERROR)
     {
-        if (!begin_time())
-        {
-            sprintf(time_buff, "");
-            return time_buff;
-        }
+        sprintf(time_buff, "");
+        return time_buff;
     }
 
-    time_since_epoch += (millis()/1000) - start_time;
-    start_time = millis()/1000;
     std::tm *timeResult{};
     timeResult = std::gmtime( &time_since_epoch );
     sprintf(time_buff, "[%04d-%02d-%02d %02d:%02d:%02d] ", timeResult->tm_year + 1900, timeResult->tm_mday, timeResult->tm_mon +1
@@ -52,17 +57,13 @@ char* get_utc_time()
 
 char* get_utc_time_format_()
 {
-    if (!initialized)
+    time_t time_since_epoch = get_time_since_epoch();
+    if (time_since_epoch == TIME_ERROR)
     {
-        if (!begin_time())
-        {
-            sprintf(time_buff, "");
-            return time_buff;
-        }
+        sprintf(time_buff, "");
+        return time_buff;
     }
 
-    time_since_epoch += (millis()/1000) - start_time;
-    start_time = millis()/1000;
     std::tm *timeResult{};
     timeResult = std::gmtime( &time_since_epoch );
     sprintf(time_buff, "%04d%02d%02d%02d%02d%02d", timeResult->tm_year + 1900 ,timeResult->tm_mday, timeResult->tm_mon +1
@@ -72,33 +73,135 @@ char* get_utc_time_format_()
 
 time_t get_time_since_epoch()
 {
+    return get_time_since_epoch_us() / 1000000;
+}
+
+bool time_is_synchronized()
+{
+    return synchronized;
+}
+
+uint64_t get_time_since_epoch_us()
+{
+    /* The clock restored from RTC memory is replaced with NTP time as soon as wifi is connected. */
+    if (!synchronized && WiFi.isConnected())
+        synchronize_time();
+
     if (!initialized)
     {
         if (!begin_time())
             return TIME_ERROR;
     }
-    time_since_epoch += (millis()/1000) - start_time;
-    start_time = millis()/1000;
 
-    return time_since_epoch;
+    return device_clock.boot_time_us + micros64();
+}
+
+uint64_t time_prepare_sleep(uint64_t sleep_time)
+{
+    uint64_t request;
+
+    if (!initialized)
+    {
+        if (!begin_time())
+            return sleep_time;
+    }
+
+    request = sleep_time * 1000000 / (1000000 + device_clock.drift);
+    if (request > ESP.deepSleepMax())
+    {
+        /* The clock follows the time the device will actually sleep. */
+        request = ESP.deepSleepMax();
+        sleep_time = request * (1000000 + device_clock.drift) / 1000000;
+    }
+
+    rtc_clock next_clock = device_clock;
+    next_clock.boot_time_us += micros64() + sleep_time;
+    rtc_memory_write(RTC_SLOT_CLOCK, &next_clock, sizeof(next_clock));
+
+    return request;
 }
 
 /**
- * @brief Time tool initializationh
+ * @brief Time tool initialization, restores the clock from RTC memory after deep sleep.
  * @return true if successful, otherwise false.
  */
 static bool begin_time()
 {
-    if (!WiFi.isConnected())
+    if (synchronize_time())
+        return true;
+
+    /* After other resets the time spent without power is unknown. */
+    if (ESP.getResetInfoPtr()->reason != REASON_DEEP_SLEEP_AWAKE)
+        return false;
+
+    if (!rtc_memory_read(RTC_SLOT_CLOCK, &device_clock, sizeof(device_clock)))
+        return false;
+
+    device_clock.drift = constrain(device_clock.drift, -TIME_DRIFT_MAX, TIME_DRIFT_MAX);
+    initialized = true;
+    return true;
+}
+
+/**
+ * @brief Synchronizes the clock with the NTP server, only one attempt per wake-up.
+ * @return true if successful, otherwise false.
+ */
+static bool synchronize_time()
+{
+    static bool attempted = false;
+
+    if (synchronized)
+        return true;
+
+    if (attempted || !WiFi.isConnected())
         return false;
-        
+
+    attempted = true;
     time_client.begin();
     if (!time_client.update())
+    {
+        time_client.end();
         return false;
+    }
+
+    /* The clock predicted across the deep sleeps is kept to measure the drift of the sleep timer. */
+    rtc_clock predicted = device_clock;
+    bool restored = initialized;
 
-    time_since_epoch = time_client.getEpochTime();
-    start_time = 0;
+    if (!restored && (ESP.getResetInfoPtr()->reason == REASON_DEEP_SLEEP_AWAKE))
+        restored = rtc_memory_read(RTC_SLOT_CLOCK, &predicted, sizeof(predicted));
+
+    device_clock.ntp_time = time_client.getEpochTime();
+    device_clock.boot_time_us = ((uint64_t)device_clock.ntp_time * 1000000) - micros64();
+    device_clock.drift = 0;
     time_client.end();
+
+    if (restored)
+        measure_drift(predicted);
+
     initialized = true;
+    synchronized = true;
     return true;
 }
+
+/**
+ * @brief Corrects the drift of the deep sleep timer with the error of the clock predicted across the sleeps.
+ * @param [in] predicted - clock restored from RTC memory, before the NTP synchronization
+ */
+static void measure_drift(const rtc_clock &predicted)
+{
+    int32_t drift = constrain(predicted.drift, -TIME_DRIFT_MAX, TIME_DRIFT_MAX);
+    uint32_t window = device_clock.ntp_time - predicted.ntp_time;
+
+    device_clock.drift = drift;
+
+    /* NTP time has a resolution of one second, a short window gives a coarse measurement. */
+    if ((predicted.ntp_time == 0) || (window < TIME_DRIFT_WINDOW_MIN) || (window > TIME_DRIFT_WINDOW_MAX))
+        return;
+
+    /* Error of the prediction in us per second of the window, the remaining drift in ppm. */
+    int64_t error = (int64_t)(device_clock.boot_time_us - predicted.boot_time_us);
+    int64_t residual = error / window;
+
+    device_clock.drift = (int32_t)constrain(drift + residual / TIME_DRIFT_GAIN, -TIME_DRIFT_MAX, TIME_DRIFT_MAX);
+}
@@ -9,6 +9,7 @@
 
 #include <ArduinoJson.h>
 #include <FS.h>
+#include <lwip/dhcp.h>
 #include <wifi_manager.h>
 #include <log_debug.h>
 #include <config_manager.h>
@@ -17,6 +18,8 @@
 
 void WifiManager::begin()
 {
+    fast_connected = false;
+
     if (!load_config())
     {
         LOG("[WIFI MANAGER] WIFI CONFIG LOAD ERROR");
@@ -24,9 +27,11 @@ void WifiManager::begin()
         return;
     }
     
-    WiFi.begin(ssid, pass);
+    /* Credentials are already in the config, the SDK does not need to save them in flash. */
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
 
-    if (WiFi.waitForConnectResult(WIFI_TIMEOUT) != WL_CONNECTED)
+    if (!fast_connect() && !full_connect())
     {
         LOG("[WIFI MANAGER] WIFI connection timeout!");
         initialized = false;
@@ -44,6 +49,93 @@ bool WifiManager::is_connected()
     return (WiFi.status() == WL_CONNECTED);
 }
 
+uint32_t WifiManager::get_connect_time()
+{
+    return connect_time;
+}
+
+bool WifiManager::fast_connect()
+{
+    wifi_rtc cache;
+    unsigned long ms = millis();
+
+    if (!rtc_memory_read(RTC_SLOT_WIFI, &cache, sizeof(cache)) || (cache.channel == 0))
+        return false;
+
+    /* Past the renewal time the server may give the address to another host. */
+    time_t now = get_time_since_epoch();
+    if ((now == TIME_ERROR) || ((uint32_t)now >= cache.renew))
+    {
+        LOG("[WIFI MANAGER] Cached lease expired.");
+        return false;
+    }
+
+    WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+    WiFi.begin(ssid, pass, cache.channel, cache.bssid, true);
+
+    bool connected = (WiFi.waitForConnectResult(WIFI_FAST_TIMEOUT) == WL_CONNECTED);
+    connect_time = millis() - ms;
+    LOG("[WIFI MANAGER] Fast connect " + String(connected ? "successful" : "failed") + " : " + String(connect_time) + " ms");
+
+    if (!connected)
+    {
+        /* The access point or the lease has changed, the next attempt scans again. */
+        memset(&cache, 0, sizeof(cache));
+        rtc_memory_write(RTC_SLOT_WIFI, &cache, sizeof(cache));
+        WiFi.disconnect();
+        WiFi.config(IPAddress(0u), IPAddress(0u), IPAddress(0u));
+    }
+
+    fast_connected = connected;
+    return connected;
+}
+
+bool WifiManager::full_connect()
+{
+    wifi_rtc cache;
+    unsigned long ms = millis();
+
+    WiFi.begin(ssid, pass);
+
+    bool connected = (WiFi.waitForConnectResult(WIFI_TIMEOUT) == WL_CONNECTED);
+    connect_time = millis() - ms;
+    LOG("[WIFI MANAGER] Full connect " + String(connected ? "successful" : "failed") + " : " + String(connect_time) + " ms");
+
+    if (!connected)
+        return false;
+
+    memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+    cache.channel = WiFi.channel();
+    cache.reserved = 0;
+    cache.ip = WiFi.localIP();
+    cache.gateway = WiFi.gatewayIP();
+    cache.subnet = WiFi.subnetMask();
+    cache.dns = WiFi.dnsIP();
+
+    /* The cache is used until the renewal time, half of the lease, like a DHCP client would renew it. */
+    struct dhcp *dhcp = netif_dhcp_data(netif_default);
+    uint32_t lease = ((dhcp != nullptr) && (dhcp->offered_t0_lease > 0)) ? dhcp->offered_t0_lease : WIFI_LEASE_TIME_DEFAULT;
+    time_t now = get_time_since_epoch();
+
+    cache.renew = (now == TIME_ERROR) ? 0 : (uint32_t)now + lease / 2;
+    rtc_memory_write(RTC_SLOT_WIFI, &cache, sizeof(cache));
+
+    return true;
+}
+
+void WifiManager::drop_cached_lease()
+{
+    wifi_rtc cache;
+
+    if (!fast_connected)
+        return;
+
+    memset(&cache, 0, sizeof(cache));
+    rtc_memory_write(RTC_SLOT_WIFI, &cache, sizeof(cache));
+    fast_connected = false;
+    LOG("[WIFI MANAGER] Cached lease dropped.");
+}
+
 bool WifiManager::load_config()
 {
     ConfigManager& config = ConfigManager::get_instance();
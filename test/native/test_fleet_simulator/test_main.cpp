@@ -0,0 +1,403 @@
+/**
+ * @file test_main.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <algorithm>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <unity.h>
+#include <measurement_codec.h>
+#include <scheduler.h>
+#include <host_sender.h>
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+/* Flash log of a device, the page layout of DataLog. */
+#define FLEET_LOG_PAGE_SIZE     256     /**< DATA_LOG_PAGE_SIZE. */
+#define FLEET_LOG_PAGE_HEADER   12      /**< sizeof(data_log_page_header). */
+#define FLEET_LOG_PAGES         64      /**< DATA_LOG_PAGES. */
+
+/** @brief Time from the wake-up to the connected WiFi, in us. */
+#define FLEET_WIFI_CONNECT      2000000ULL
+
+/** @brief Time from the wake-up to the sleep of a device which does not upload, in us. */
+#define FLEET_AWAKE             3000000ULL
+
+/** @brief Largest error of the deep sleep timer left after the drift correction, in ppm. */
+#define FLEET_DRIFT_MAX         2000
+
+/** @brief Start of the simulation since epoch, in us. */
+#define FLEET_EPOCH_START       (1790000000ULL * 1000000)
+
+#define HOUR                    3600000000ULL
+
+static const char *email = "brewery@example.com";
+
+/** @brief Shared database of the brewery, throttled to show the write bursts, some answers to applied updates are lost. */
+static const rtdb_stand_in_config network_fleet =
+{
+    .latency = 60000, .jitter = 40000, .handshake = 1500000, .bandwidth = 50000, .service = 200, .workers = 8,
+    .rate_limit = 50, .auth_service = 150000, .token_lifetime = 3600, .timeout = 5000000, .error_rate = 0.001f, .loss_rate = 0.001f,
+    .reply_loss_rate = 0.001f
+};
+
+/** @brief Scenario of a fleet simulation. */
+struct fleet_scenario
+{
+    const char *name;           /**< Name in the report. */
+    uint32_t devices;           /**< Number of devices. */
+    uint64_t sleep_time;        /**< Configured interval between wake-ups, in us. */
+    uint64_t duration;          /**< Simulated time, in us. */
+    uint64_t outage_start;      /**< Start of the WiFi outage of the whole brewery, since the start, in us. */
+    uint64_t outage_end;        /**< End of the outage, equal to the start if there is none. */
+    float connect_failure;      /**< Probability that a single device fails to connect outside the outage. */
+    bool spread;                /**< false: all devices wake on the grid point and retry without backoff. */
+    size_t records_max;         /**< Maximum number of measurements in a single update. */
+};
+
+/** @brief Results of a fleet simulation. */
+struct fleet_result
+{
+    uint32_t generated;         /**< Measurements taken. */
+    uint32_t stored;            /**< Measurements in the database. */
+    uint32_t pending;           /**< Measurements left in the logs at the end. */
+    uint32_t pending_stored;    /**< Measurements left in the logs which are already in the database, their answer was lost. */
+    uint32_t dropped;           /**< Measurements overwritten in full logs. */
+    uint32_t peak_qps;          /**< Most updates in a single second. */
+    uint32_t rejected;          /**< Requests rejected by the rate limit. */
+    uint64_t convergence;       /**< Time from the end of the outage until all logs were empty, UINT64_MAX if they never were. */
+};
+
+static uint32_t seed;
+
+//--------------------------------------------------------------------------------
+/* Private functions definitions. */
+
+static uint32_t random_next()
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static float random_unit()
+{
+    return (random_next() >> 8) / 16777216.0f;
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Flash log of a simulated device, the measurements are encoded with MeasurementCodec in pages
+ *        of the DataLog size, every page is a stream of its own. When the log is full the oldest page
+ *        is overwritten.
+ */
+class FleetLog
+{
+public:
+
+    FleetLog() : dropped(0), size(0) {}
+
+    void append(const data &measurement)
+    {
+        if (this->pages.empty() || !encode(measurement))
+        {
+            this->pages.emplace_back();
+            this->encoder.reset();
+            encode(measurement);
+        }
+
+        this->size++;
+
+        if (this->pages.size() > FLEET_LOG_PAGES)
+        {
+            this->size -= this->pages.front().count;
+            this->dropped += this->pages.front().count;
+            this->pages.pop_front();
+        }
+    }
+
+    void read(std::deque<data> &records) const
+    {
+        for (const page &p : this->pages)
+        {
+            MeasurementCodec decoder;
+            size_t offset = 0;
+
+            for (uint32_t i = 0; i < p.count; i++)
+            {
+                data measurement;
+                size_t length = decoder.decode(&p.bytes[offset], p.used - offset, &measurement);
+                TEST_ASSERT_GREATER_THAN(0, length);
+
+                offset += length;
+                records.push_back(measurement);
+            }
+        }
+    }
+
+    /** @brief Keeps only the measurements which were not sent, like DataLog::drop(). */
+    void rewrite(const std::deque<data> &records)
+    {
+        this->pages.clear();
+        this->size = 0;
+
+        for (const data &measurement : records)
+            append(measurement);
+    }
+
+    uint32_t count() const
+    {
+        return this->size;
+    }
+
+    uint32_t dropped;   /**< Measurements lost in overwritten pages. */
+
+private:
+
+    struct page
+    {
+        uint8_t bytes[FLEET_LOG_PAGE_SIZE - FLEET_LOG_PAGE_HEADER];
+        size_t used = 0;
+        uint32_t count = 0;
+    };
+
+    bool encode(const data &measurement)
+    {
+        page &p = this->pages.back();
+        size_t length = this->encoder.encode(measurement, &p.bytes[p.used], sizeof(p.bytes) - p.used);
+
+        p.used += length;
+        p.count += (length > 0);
+        return length > 0;
+    }
+
+    std::deque<page> pages;
+    MeasurementCodec encoder;
+    uint32_t size;
+};
+
+/** @brief Simulated hydrometer. */
+struct fleet_device
+{
+    fleet_device(RtdbStandIn &database, uint32_t id, size_t records_max) : sender(database, email, id, records_max), id(id) {}
+
+    HostSender sender;          /**< Upload path. */
+    uint32_t id;                /**< Chip ID. */
+    FleetLog log;               /**< Measurements waiting for the upload. */
+    uint32_t offset_seed;       /**< Seed of the grid offset, the CRC of the chip ID on the device. */
+    int32_t drift;              /**< Error of the deep sleep timer, in ppm. */
+    int64_t clock_error;        /**< Difference of the device clock to the real time, in us. */
+    bool synchronized;          /**< Flag indicating the clock was set from NTP at least once. */
+    uint8_t failures;           /**< Consecutive failed wake-ups. */
+    uint32_t index;             /**< Number of taken measurements. */
+    uint64_t drained;           /**< Time the log was first found empty after the outage, in us. */
+};
+
+/**
+ * @brief Runs the wake-ups of all devices in the order of their time until the end of the scenario.
+ * @param [in] scenario - scenario
+ * @return fleet_result - results
+ */
+static fleet_result simulate(const fleet_scenario &scenario)
+{
+    RtdbStandIn database(network_fleet, scenario.devices);
+    std::deque<fleet_device> devices;
+    std::priority_queue<std::pair<uint64_t, uint32_t>, std::vector<std::pair<uint64_t, uint32_t>>, std::greater<>> wakes;
+    uint64_t end = FLEET_EPOCH_START + scenario.duration;
+    uint64_t outage_start = FLEET_EPOCH_START + scenario.outage_start;
+    uint64_t outage_end = FLEET_EPOCH_START + scenario.outage_end;
+    fleet_result result = {};
+
+    seed = 2463534242u;
+
+    /* Devices are powered up at random times within the first interval. */
+    for (uint32_t i = 0; i < scenario.devices; i++)
+    {
+        fleet_device &device = devices.emplace_back(database, i, scenario.records_max);
+
+        device.offset_seed = scenario.spread ? random_next() : 0;
+        device.drift = (int32_t)(random_next() % (2 * FLEET_DRIFT_MAX + 1)) - FLEET_DRIFT_MAX;
+        device.clock_error = 0;
+        device.synchronized = false;
+        device.failures = 0;
+        device.index = 0;
+        device.drained = 0;
+        wakes.emplace(FLEET_EPOCH_START + random_next() % (scenario.sleep_time / 1000) * 1000, i);
+    }
+
+    while (!wakes.empty() && (wakes.top().first < end))
+    {
+        uint64_t time = wakes.top().first;
+        fleet_device &device = devices[wakes.top().second];
+        uint32_t id = wakes.top().second;
+        wakes.pop();
+
+        data measurement = {18.0f + (device.index % 64) / 16.0f, 12.0f - device.index / 100.0f, 4.1f - device.index / 10000.0f,
+                            device.synchronized ? (uint32_t)((time + device.clock_error) / 1000000) : 0, device.index};
+        bool outage = (time >= outage_start) && (time < outage_end);
+        bool online = !outage && (random_unit() >= scenario.connect_failure);
+        uint64_t awake_end = time + FLEET_AWAKE;
+
+        device.index++;
+        result.generated++;
+
+        if (online)
+        {
+            std::deque<data> backlog;
+
+            /* NTP sets the clock as soon as WiFi connects. */
+            device.synchronized = true;
+            device.clock_error = 0;
+
+            device.log.read(backlog);
+            bool sent = device.sender.send_data(time + FLEET_WIFI_CONNECT, backlog, &measurement);
+            device.log.rewrite(backlog);
+
+            awake_end = std::max(awake_end, device.sender.get_time());
+            device.failures = sent ? 0 : device.failures + 1;
+
+            if ((device.log.count() == 0) && (device.drained < outage_end))
+                device.drained = awake_end;
+        }
+        else
+        {
+            device.log.append(measurement);
+            device.failures++;
+        }
+
+        /* The deep sleep timer runs fast or slow, the device clock follows the requested sleep. */
+        uint64_t local = device.synchronized ? awake_end + device.clock_error : 0;
+        uint64_t sleep = scheduler_sleep(local, scenario.sleep_time, device.offset_seed,
+                                         scenario.spread ? device.failures : 0, random_next());
+        int64_t error = (int64_t)sleep * device.drift / 1000000;
+
+        device.clock_error -= error;
+        wakes.emplace(awake_end + sleep + error, id);
+    }
+
+    const rtdb_stand_in_stats &stats = database.get_stats();
+    std::string readings = "UsersData/" + devices.front().sender.get_uid() + "/readings";
+    uint64_t converged = 0;
+    uint32_t requests = 0;
+
+    result.stored = database.count(readings + "/temperature");
+    result.rejected = stats.rejected;
+
+    for (const fleet_device &device : devices)
+    {
+        std::deque<data> backlog;
+        device.log.read(backlog);
+
+        for (const data &record : backlog)
+        {
+            char key[SENDER_KEY_BUF_SIZE];
+            sender_record_key(record, device.id, record.time != HOST_SENDER_TIME_ERROR, key);
+            result.pending_stored += (database.get(readings + "/temperature/" + key) != nullptr);
+        }
+
+        result.pending += device.log.count();
+        result.dropped += device.log.dropped;
+        requests += device.sender.get_stats().requests;
+        converged = std::max(converged, (device.drained >= outage_end) ? device.drained : UINT64_MAX);
+    }
+
+    result.convergence = (converged == UINT64_MAX) ? UINT64_MAX : converged - outage_end;
+
+    /* Seconds without any update count as zero load. */
+    std::vector<uint32_t> load(scenario.duration / 1000000, 0);
+    for (auto &second : stats.load)
+    {
+        if ((second.first >= FLEET_EPOCH_START / 1000000) && (second.first - FLEET_EPOCH_START / 1000000 < load.size()))
+            load[second.first - FLEET_EPOCH_START / 1000000] = second.second;
+    }
+
+    std::vector<uint32_t> latencies = stats.latencies;
+    std::sort(load.begin(), load.end());
+    std::sort(latencies.begin(), latencies.end());
+    result.peak_qps = load.back();
+
+    char report[320];
+    snprintf(report, sizeof(report),
+             "%-12s %4u devices: %6u requests, %5u rejected, QPS peak %3u p99.9 %3u mean %.2f, "
+             "latency p50 %5.0f ms p99 %6.0f ms p99.9 %6.0f ms, convergence %s%.1f min, "
+             "%u/%u stored, %u pending, %u dropped",
+             scenario.name, scenario.devices, requests, result.rejected, result.peak_qps,
+             load[load.size() * 999 / 1000], (double)stats.updates / load.size(),
+             latencies[latencies.size() / 2] / 1e3, latencies[latencies.size() * 99 / 100] / 1e3,
+             latencies[latencies.size() * 999 / 1000] / 1e3,
+             (result.convergence == UINT64_MAX) ? "never " : "", (result.convergence == UINT64_MAX) ? 0.0 : result.convergence / 60e6,
+             result.stored, result.generated, result.pending, result.dropped);
+    TEST_MESSAGE(report);
+
+    /* Every measurement is stored once, still waits in a log or was overwritten in a full one.
+       A retried measurement is not stored twice, one whose answer was lost may be stored and waiting. */
+    TEST_ASSERT_EQUAL_UINT32(result.generated, result.stored + result.pending - result.pending_stored + result.dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.malformed);
+    return result;
+}
+
+//--------------------------------------------------------------------------------
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+//--------------------------------------------------------------------------------
+
+static void test_steady_state()
+{
+    fleet_scenario scenario = {"steady", 500, HOUR / 4, 12 * HOUR, 0, 0, 0.01f, true, SENDER_BATCH_RECORDS_MAX};
+    fleet_result result = simulate(scenario);
+
+    TEST_ASSERT_EQUAL_UINT32(0, result.dropped);
+}
+
+static void test_outage_recovery()
+{
+    /* WiFi of the brewery is down for four hours, the fleet catches up afterwards. */
+    fleet_scenario firmware = {"outage", 500, HOUR / 4, 12 * HOUR, 2 * HOUR, 6 * HOUR, 0.01f, true, SENDER_BATCH_RECORDS_MAX};
+    fleet_scenario synchronized = {"outage-sync", 500, HOUR / 4, 12 * HOUR, 2 * HOUR, 6 * HOUR, 0.01f, false, 1};
+
+    fleet_result spread = simulate(firmware);
+    fleet_result burst = simulate(synchronized);
+
+    /* Grid offsets, backoff and batches keep the load of the recovery below the synchronized per-record pushes. */
+    TEST_ASSERT_TRUE(spread.convergence != UINT64_MAX);
+    TEST_ASSERT_TRUE(spread.convergence < 2 * HOUR);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(network_fleet.rate_limit, spread.peak_qps);
+    TEST_ASSERT_TRUE(spread.rejected < burst.rejected);
+    TEST_ASSERT_EQUAL_UINT32(0, spread.dropped);
+}
+
+static void test_large_fleet()
+{
+    fleet_scenario scenario = {"large", 2000, HOUR / 4, 6 * HOUR, 1 * HOUR, 3 * HOUR, 0.01f, true, SENDER_BATCH_RECORDS_MAX};
+    fleet_result result = simulate(scenario);
+
+    TEST_ASSERT_TRUE(result.convergence != UINT64_MAX);
+}
+
+//--------------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_state);
+    RUN_TEST(test_outage_recovery);
+    RUN_TEST(test_large_fleet);
+    return UNITY_END();
+}
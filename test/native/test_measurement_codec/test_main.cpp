@@ -0,0 +1,232 @@
+/**
+ * @file test_main.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <measurement_codec.h>
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+#define STREAM_SIZE     4096
+#define STREAM_COUNT    2000
+#define GARBAGE_SIZE    24
+#define GARBAGE_COUNT   100000
+
+static uint32_t seed;
+
+//--------------------------------------------------------------------------------
+/* Private functions definitions. */
+
+/** @brief Deterministic xorshift generator, the same streams on every run. */
+static uint32_t random_next()
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static int32_t random_range(int32_t min, int32_t max)
+{
+    return min + (int32_t)(random_next() % (uint32_t)(max - min + 1));
+}
+
+static void assert_fixed_equal(const data &expected, const data &actual)
+{
+    measurement_fixed a = MeasurementCodec::to_fixed(expected);
+    measurement_fixed b = MeasurementCodec::to_fixed(actual);
+
+    TEST_ASSERT_EQUAL_UINT32(a.time, b.time);
+    TEST_ASSERT_EQUAL_INT32(a.temperature, b.temperature);
+    TEST_ASSERT_EQUAL_INT32(a.plato, b.plato);
+    TEST_ASSERT_EQUAL_INT32(a.voltage, b.voltage);
+    TEST_ASSERT_EQUAL_UINT32(a.sequence, b.sequence);
+}
+
+//--------------------------------------------------------------------------------
+
+void setUp()
+{
+    seed = 2463534242u;
+}
+
+void tearDown()
+{
+}
+
+//--------------------------------------------------------------------------------
+
+static void test_round_trip()
+{
+    static data records[STREAM_SIZE];
+    uint8_t *stream = (uint8_t *)malloc(STREAM_SIZE);
+
+    for (int n = 0; n < STREAM_COUNT; n++)
+    {
+        MeasurementCodec encoder, decoder;
+        data measurement = {20, 12, 4.1f, 1700000000, random_next()};
+        size_t count = 0, size = 0, length;
+        int32_t records_max = random_range(0, 300);
+
+        for (int32_t i = 0; i < records_max; i++)
+        {
+            data record;
+            int32_t mode = random_range(0, 9);
+
+            if (mode == 0)
+            {
+                /* Values far from the previous record and out of the fixed-point range. */
+                record.temperature = random_range(-50000, 50000);
+                record.plato = (float)(int32_t)random_next() * 100;
+                record.battery_voltage = random_next();
+                record.time = random_next();
+                record.sequence = random_next();
+            }
+            else
+            {
+                measurement.temperature += random_range(-4, 4) / 16.0f;
+                measurement.plato += random_range(-10, 10) / 100.0f;
+                measurement.battery_voltage += random_range(-5, 5) / 1000.0f;
+                measurement.time += 900 + random_range(0, 4);
+                measurement.sequence++;
+                record = measurement;
+
+                if (mode == 1)
+                    record.time = 0;
+                else if (mode == 2)
+                    record.temperature = -127;
+                else if (mode == 3)
+                    measurement.sequence += random_range(1, 1000);
+            }
+
+            length = encoder.encode(record, stream + size, STREAM_SIZE - size);
+            if (length == 0)
+                break;
+
+            size += length;
+            records[count++] = record;
+        }
+
+        size_t position = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            data decoded;
+            length = decoder.decode(stream + position, size - position, &decoded);
+            TEST_ASSERT_GREATER_THAN(0, length);
+
+            position += length;
+            assert_fixed_equal(records[i], decoded);
+        }
+
+        TEST_ASSERT_EQUAL_size_t(size, position);
+    }
+
+    free(stream);
+}
+
+static void test_decode_truncated()
+{
+    MeasurementCodec encoder;
+    uint8_t record[MEASUREMENT_CODEC_MAX_SIZE];
+    data measurement = {-12.5f, 85.31f, 3.215f, 4000000000u, 3000000000u};
+    data decoded;
+
+    size_t size = encoder.encode(measurement, record, sizeof(record));
+    TEST_ASSERT_GREATER_THAN(0, size);
+
+    /* Every prefix is copied to a buffer of its own size, so a read beyond it is caught by the sanitizer. */
+    for (size_t length = 0; length < size; length++)
+    {
+        MeasurementCodec decoder;
+        uint8_t *prefix = (uint8_t *)malloc(length > 0 ? length : 1);
+        memcpy(prefix, record, length);
+
+        TEST_ASSERT_EQUAL_size_t(0, decoder.decode(prefix, length, &decoded));
+        free(prefix);
+    }
+
+    MeasurementCodec decoder;
+    TEST_ASSERT_EQUAL_size_t(size, decoder.decode(record, size, &decoded));
+    assert_fixed_equal(measurement, decoded);
+}
+
+static void test_encode_does_not_fit()
+{
+    MeasurementCodec encoder, decoder;
+    uint8_t stream[2 * MEASUREMENT_CODEC_MAX_SIZE];
+    data first = {20, 12, 4.1f, 1700000000, 7};
+    data second = {21, 11, 4.0f, 1700000900, 8};
+    data decoded;
+
+    size_t size = encoder.encode(first, stream, sizeof(stream));
+    TEST_ASSERT_EQUAL_size_t(0, encoder.encode(second, stream + size, 1));
+
+    /* The failed record does not change the stream, it can be encoded again. */
+    size_t length = encoder.encode(second, stream + size, sizeof(stream) - size);
+    TEST_ASSERT_GREATER_THAN(0, length);
+
+    TEST_ASSERT_EQUAL_size_t(size, decoder.decode(stream, size + length, &decoded));
+    assert_fixed_equal(first, decoded);
+    TEST_ASSERT_EQUAL_size_t(length, decoder.decode(stream + size, length, &decoded));
+    assert_fixed_equal(second, decoded);
+}
+
+static void test_reset()
+{
+    MeasurementCodec encoder, decoder;
+    uint8_t record[MEASUREMENT_CODEC_MAX_SIZE];
+    data first = {20, 12, 4.1f, 1700000000, 7};
+    data second = {21, 11, 4.0f, 1700000900, 8};
+    data decoded;
+
+    encoder.encode(first, record, sizeof(record));
+    encoder.reset();
+
+    /* After reset the record is encoded against zero and decodes on its own. */
+    size_t size = encoder.encode(second, record, sizeof(record));
+    TEST_ASSERT_EQUAL_size_t(size, decoder.decode(record, size, &decoded));
+    assert_fixed_equal(second, decoded);
+}
+
+static void test_decode_garbage()
+{
+    uint8_t *garbage = (uint8_t *)malloc(GARBAGE_SIZE);
+
+    for (int n = 0; n < GARBAGE_COUNT; n++)
+    {
+        MeasurementCodec decoder;
+        data decoded;
+        size_t position = 0, length;
+
+        for (size_t i = 0; i < GARBAGE_SIZE; i++)
+            garbage[i] = (uint8_t)random_next();
+
+        while ((length = decoder.decode(garbage + position, GARBAGE_SIZE - position, &decoded)) > 0)
+            position += length;
+
+        TEST_ASSERT_LESS_OR_EQUAL(GARBAGE_SIZE, position);
+    }
+
+    free(garbage);
+}
+
+//--------------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_decode_truncated);
+    RUN_TEST(test_encode_does_not_fit);
+    RUN_TEST(test_reset);
+    RUN_TEST(test_decode_garbage);
+    return UNITY_END();
+}
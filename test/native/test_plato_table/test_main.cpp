@@ -0,0 +1,158 @@
+/**
+ * @file test_main.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <math.h>
+#include <unity.h>
+#include <plato_table.h>
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+/** @brief Coefficients of a typical calibration, gravity 0.990 to 1.100 over the tilt range. */
+static const float coefficients[5] = {0.0f, 0.0f, 0.000001f, 0.0017f, 0.955f};
+
+/** @brief Calibration with the curvature of the accuracy harness, steepest at high tilt. */
+static const float coefficients_steep[5] = {0.0000000025f, -0.0000004f, 0.00002f, 0.0013f, 0.955f};
+
+/** @brief Calibration with a curvature the grid cannot follow, gravity 1.020 to 1.065. */
+static const float coefficients_curved[5] = {0.0f, 0.0f, 0.00005f, -0.005f, 1.145f};
+
+static PlatoTable table;
+
+//--------------------------------------------------------------------------------
+/* Private functions definitions. */
+
+/**
+ * @brief Compares every successful lookup with the exact formula on a grid finer than the table.
+ * @param [in] table - table initialized for the coefficients
+ * @param [in] coefficients - calibration
+ * @param [in] tilt_max - end of the checked tilt range
+ * @return size_t - number of lookups which failed inside the table range
+ */
+static size_t check_lookups(PlatoTable &table, const float (&coefficients)[5], float tilt_max = 80)
+{
+    size_t failed = 0;
+
+    for (float tilt = PLATO_TABLE_TILT_MIN; tilt <= tilt_max; tilt += 0.13f)
+    {
+        for (float temperature = PLATO_TABLE_TEMPERATURE_MIN; temperature <= 30; temperature += 0.7f)
+        {
+            float plato;
+
+            if (!table.lookup(tilt, temperature, &plato))
+            {
+                failed++;
+                continue;
+            }
+
+            TEST_ASSERT_FLOAT_WITHIN(PLATO_TABLE_ERROR_MAX, PlatoTable::calculate(coefficients, tilt, temperature), plato);
+        }
+    }
+
+    return failed;
+}
+
+//--------------------------------------------------------------------------------
+
+void setUp()
+{
+    table.init(coefficients);
+}
+
+void tearDown()
+{
+}
+
+//--------------------------------------------------------------------------------
+
+static void test_lookup_matches_calculate()
+{
+    TEST_ASSERT_EQUAL_size_t(0, check_lookups(table, coefficients));
+    TEST_ASSERT_TRUE(table.get_error_max() > 0);
+    TEST_ASSERT_TRUE(table.get_error_max() <= PLATO_TABLE_ERROR_MAX);
+}
+
+static void test_lookup_matches_calculate_steep()
+{
+    PlatoTable steep;
+    steep.init(coefficients_steep);
+
+    /* Only the cells of the steepest end exceed the limit and fall back to the formula. */
+    TEST_ASSERT_EQUAL_size_t(0, check_lookups(steep, coefficients_steep, 74));
+    TEST_ASSERT_GREATER_THAN(0, check_lookups(steep, coefficients_steep));
+}
+
+static void test_coarse_cells_use_calculate()
+{
+    PlatoTable curved;
+    curved.init(coefficients_curved);
+
+    /* Cells the interpolation cannot follow are rejected, the others stay within the limit. */
+    TEST_ASSERT_GREATER_THAN(0, check_lookups(curved, coefficients_curved));
+    TEST_ASSERT_TRUE(curved.get_error_max() > PLATO_TABLE_ERROR_MAX);
+}
+
+static void test_lookup_grid_point_is_exact()
+{
+    float plato;
+    TEST_ASSERT_TRUE(table.lookup(PLATO_TABLE_TILT_MIN + 5 * PLATO_TABLE_TILT_STEP, 20, &plato));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / PLATO_TABLE_SCALE, PlatoTable::calculate(coefficients, PLATO_TABLE_TILT_MIN + 5 * PLATO_TABLE_TILT_STEP, 20), plato);
+}
+
+static void test_lookup_upper_edge()
+{
+    float tilt = PLATO_TABLE_TILT_MIN + (PLATO_TABLE_TILT_SIZE - 1) * PLATO_TABLE_TILT_STEP;
+    float temperature = PLATO_TABLE_TEMPERATURE_MIN + (PLATO_TABLE_TEMPERATURE_SIZE - 1) * PLATO_TABLE_TEMPERATURE_STEP;
+    float plato;
+
+    TEST_ASSERT_TRUE(table.lookup(tilt, temperature, &plato));
+}
+
+static void test_lookup_out_of_range()
+{
+    float plato;
+
+    TEST_ASSERT_FALSE(table.lookup(PLATO_TABLE_TILT_MIN - 0.1f, 20, &plato));
+    TEST_ASSERT_FALSE(table.lookup(PLATO_TABLE_TILT_MIN + PLATO_TABLE_TILT_SIZE * PLATO_TABLE_TILT_STEP, 20, &plato));
+    TEST_ASSERT_FALSE(table.lookup(40, PLATO_TABLE_TEMPERATURE_MIN - 0.1f, &plato));
+    TEST_ASSERT_FALSE(table.lookup(40, PLATO_TABLE_TEMPERATURE_ERROR, &plato));
+    TEST_ASSERT_FALSE(table.lookup(NAN, 20, &plato));
+    TEST_ASSERT_FALSE(table.lookup(40, NAN, &plato));
+}
+
+static void test_lookup_not_initialized()
+{
+    PlatoTable empty;
+    float plato;
+
+    TEST_ASSERT_FALSE(empty.lookup(40, 20, &plato));
+}
+
+static void test_calculate_without_temperature()
+{
+    /* Without temperature the gravity of the calibration is converted as it is. */
+    TEST_ASSERT_FLOAT_WITHIN(0.002f, plato_from_gravity(polynomial_evaluate(coefficients, 50.0f)),
+                             PlatoTable::calculate(coefficients, 50, PLATO_TABLE_TEMPERATURE_ERROR));
+}
+
+//--------------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_lookup_matches_calculate);
+    RUN_TEST(test_lookup_matches_calculate_steep);
+    RUN_TEST(test_coarse_cells_use_calculate);
+    RUN_TEST(test_lookup_grid_point_is_exact);
+    RUN_TEST(test_lookup_upper_edge);
+    RUN_TEST(test_lookup_out_of_range);
+    RUN_TEST(test_lookup_not_initialized);
+    RUN_TEST(test_calculate_without_temperature);
+    return UNITY_END();
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_main.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <math.h>
+#include <unity.h>
+#include <polynomial.h>
+#include <plato_table.h>
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+/** @brief Coefficients of a typical calibration, gravity 0.986 to 1.085 over the tilt range. */
+static const double coefficients[5] = {0.0000000025, -0.0000004, 0.00002, 0.0013, 0.955};
+
+/* Range of the harness, tilt in degrees and temperature in °F. */
+#define TILT_MIN        20.0
+#define TILT_MAX        80.0
+#define TILT_STEP       0.37
+#define FAHRENHEIT_MIN  32.0
+#define FAHRENHEIT_MAX  100.0
+#define FAHRENHEIT_STEP 0.5
+
+//--------------------------------------------------------------------------------
+/* Private functions definitions. */
+
+/** @brief Reference gravity, the calibration polynomial written term by term in double. */
+static double reference_gravity(double tilt)
+{
+    return coefficients[0] * pow(tilt, 4) + coefficients[1] * pow(tilt, 3) + coefficients[2] * pow(tilt, 2) + coefficients[3] * tilt + coefficients[4];
+}
+
+/** @brief Reference correction, the formula of the original firmware written term by term in double. */
+static double reference_correction(double fahrenheit)
+{
+    return 1.00130346 - 1.34722124 * 10e-04 * fahrenheit + 2.04052596 * 10e-06 * pow(fahrenheit, 2) - 2.32820948 * 10e-09 * pow(fahrenheit, 3);
+}
+
+/** @brief Reference degrees Plato, Math in Mash SummerZym95 formula (7) written term by term in double. */
+static double reference_plato(double gravity)
+{
+    return -668.962 + 1262.45 * gravity - 776.43 * pow(gravity, 2) + 182.94 * pow(gravity, 3);
+}
+
+//--------------------------------------------------------------------------------
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+//--------------------------------------------------------------------------------
+
+static void test_gravity()
+{
+    float coefficients_float[5];
+    double coefficients_rounded[5];
+
+    /* The float coefficients themselves are rounded, the float result is compared to the same rounded values. */
+    for (size_t i = 0; i < 5; i++)
+    {
+        coefficients_float[i] = coefficients[i];
+        coefficients_rounded[i] = coefficients_float[i];
+    }
+
+    for (double tilt = TILT_MIN; tilt <= TILT_MAX; tilt += TILT_STEP)
+    {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, reference_gravity(tilt), polynomial_evaluate(coefficients, tilt));
+        TEST_ASSERT_DOUBLE_WITHIN(5e-7, polynomial_evaluate(coefficients_rounded, (double)(float)tilt),
+                                  polynomial_evaluate(coefficients_float, (float)tilt));
+    }
+}
+
+static void test_temperature_correction()
+{
+    for (double fahrenheit = FAHRENHEIT_MIN; fahrenheit <= FAHRENHEIT_MAX; fahrenheit += FAHRENHEIT_STEP)
+    {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-12, reference_correction(fahrenheit), gravity_temperature_correction<double>(fahrenheit));
+        TEST_ASSERT_DOUBLE_WITHIN(5e-7, reference_correction(fahrenheit), gravity_temperature_correction<float>(fahrenheit));
+    }
+
+    /* The Horner form keeps the factors of the deployed firmware, e.g. at 60 °F, 15.6 °C. */
+    TEST_ASSERT_DOUBLE_WITHIN(1e-5, 0.98890, gravity_temperature_correction<double>(60));
+
+    /* Warmer wort is less dense, its gravity is corrected up. */
+    TEST_ASSERT_TRUE(gravity_temperature_correction<double>(FAHRENHEIT_MAX) > gravity_temperature_correction<double>(60));
+}
+
+static void test_plato()
+{
+    for (double tilt = TILT_MIN; tilt <= TILT_MAX; tilt += TILT_STEP)
+    {
+        double gravity = reference_gravity(tilt);
+
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, reference_plato(gravity), plato_from_gravity<double>(gravity));
+        TEST_ASSERT_DOUBLE_WITHIN(0.001, reference_plato(gravity), plato_from_gravity<float>(gravity));
+
+        /* Below the 0.01 °P resolution of the stored measurement. */
+        TEST_ASSERT_DOUBLE_WITHIN(0.002, reference_plato(gravity), (double)plato_from_gravity(q16_16(gravity)));
+    }
+}
+
+static void test_calculate()
+{
+    float coefficients_float[5];
+    for (size_t i = 0; i < 5; i++)
+        coefficients_float[i] = coefficients[i];
+
+    for (double tilt = TILT_MIN; tilt <= TILT_MAX; tilt += TILT_STEP)
+    {
+        for (double fahrenheit = FAHRENHEIT_MIN; fahrenheit <= FAHRENHEIT_MAX; fahrenheit += FAHRENHEIT_STEP)
+        {
+            double celsius = (fahrenheit - 32) / 1.8;
+            double expected = reference_plato(reference_gravity(tilt) * reference_correction(fahrenheit));
+
+            TEST_ASSERT_DOUBLE_WITHIN(0.005, expected, PlatoTable::calculate(coefficients_float, tilt, celsius));
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_gravity);
+    RUN_TEST(test_temperature_correction);
+    RUN_TEST(test_plato);
+    RUN_TEST(test_calculate);
+    return UNITY_END();
+}
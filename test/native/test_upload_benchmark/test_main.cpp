@@ -0,0 +1,315 @@
+/**
+ * @file test_main.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include <profiler.h>
+#include <measurement_codec.h>
+#include <host_sender.h>
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+/** @brief Time between the wake-ups, in seconds. */
+#define WAKE_INTERVAL   900
+
+/** @brief Wake-ups after which a backlog that is not drained fails the benchmark. */
+#define WAKES_MAX       2000
+
+/** @brief Time of the first measurement of the backlog since epoch, in seconds. */
+#define EPOCH_START     1790000000
+
+/** @brief Chip ID of the simulated device. */
+#define DEVICE_ID       0x00C0FFEE
+
+static const char *email = "brewery@example.com";
+
+/** @brief WiFi of a home brewery, a TLS handshake of the ESP8266 takes about 1.5 s. */
+static const rtdb_stand_in_config network_wifi =
+{
+    .latency = 60000, .jitter = 40000, .handshake = 1500000, .bandwidth = 50000, .service = 50, .workers = 4,
+    .rate_limit = 0, .auth_service = 150000, .token_lifetime = 3600, .timeout = 5000000, .error_rate = 0, .loss_rate = 0,
+    .reply_loss_rate = 0
+};
+
+/** @brief Weak signal, failed and lost requests, lost answers to applied updates. */
+static const rtdb_stand_in_config network_lossy =
+{
+    .latency = 120000, .jitter = 300000, .handshake = 1500000, .bandwidth = 20000, .service = 50, .workers = 4,
+    .rate_limit = 0, .auth_service = 150000, .token_lifetime = 3600, .timeout = 5000000, .error_rate = 0.05f, .loss_rate = 0.02f,
+    .reply_loss_rate = 0.02f
+};
+
+/** @brief Database limiting the writes of the project. */
+static const rtdb_stand_in_config network_throttled =
+{
+    .latency = 60000, .jitter = 40000, .handshake = 1500000, .bandwidth = 50000, .service = 50, .workers = 4,
+    .rate_limit = 1, .auth_service = 150000, .token_lifetime = 3600, .timeout = 5000000, .error_rate = 0, .loss_rate = 0,
+    .reply_loss_rate = 0
+};
+
+static const uint32_t backlog_sizes[] = {10, 100, 1000, 10000};
+
+//--------------------------------------------------------------------------------
+/* Private functions definitions. */
+
+static data measurement_at(uint32_t index)
+{
+    return data{20.0f + (index % 32) / 16.0f, 12.0f - (index % 1000) / 100.0f, 4.1f - (index % 100) / 1000.0f,
+                EPOCH_START + index * WAKE_INTERVAL, index};
+}
+
+/**
+ * @brief Drains the backlog in wake-ups every WAKE_INTERVAL, each wake-up adds a new measurement.
+ * @param [in] name - name of the network in the report
+ * @param [in] config - network and database
+ * @param [in] size - number of measurements in the backlog
+ */
+static void benchmark(const char *name, const rtdb_stand_in_config &config, uint32_t size)
+{
+    RtdbStandIn database(config, size);
+    HostSender sender(database, email, DEVICE_ID);
+    std::deque<data> backlog;
+    uint32_t index = 0;
+
+    for (; index < size; index++)
+        backlog.push_back(measurement_at(index));
+
+    bool sent = false;
+    while (!sent && (sender.get_stats().wakes < WAKES_MAX))
+    {
+        data measurement = measurement_at(index);
+        sent = sender.send_data((uint64_t)measurement.time * 1000000, backlog, &measurement);
+        index++;
+    }
+
+    const host_sender_stats &stats = sender.get_stats();
+    const rtdb_stand_in_stats &database_stats = database.get_stats();
+    std::string readings = "UsersData/" + sender.get_uid() + "/readings";
+    char report[256];
+
+    snprintf(report, sizeof(report),
+             "%-9s %5u records: %4u wake-ups, %5u requests, %4u retries, %5u handshakes, "
+             "%8.1f kB sent, %7.1f kB received, %7.1f s upload, %7.2f mAh",
+             name, size, stats.wakes, stats.requests, stats.retries, database_stats.handshakes,
+             stats.sent / 1000.0, stats.received / 1000.0, stats.radio_time / 1e6,
+             PROFILER_CURRENT_UPLOAD * (stats.radio_time / 3.6e9));
+    TEST_MESSAGE(report);
+
+    /* Every measurement is stored once, also when a batch applied without an answer is sent again. */
+    TEST_ASSERT_TRUE(sent);
+    TEST_ASSERT_TRUE(backlog.empty());
+    TEST_ASSERT_EQUAL_UINT32(index, stats.records);
+    TEST_ASSERT_EQUAL_size_t(index, database.count(readings + "/temperature"));
+    TEST_ASSERT_EQUAL_size_t(index, database.count(readings + "/plato"));
+    TEST_ASSERT_EQUAL_size_t(index, database.count(readings + "/voltage"));
+    TEST_ASSERT_EQUAL_size_t(index, database.count(readings + "/time"));
+    TEST_ASSERT_EQUAL_UINT32(0, database_stats.malformed);
+    TEST_ASSERT_EQUAL_UINT32(0, database_stats.unauthorized);
+    TEST_ASSERT_TRUE((database_stats.lost_replies == 0) || (database_stats.rewrites > 0));
+}
+
+//--------------------------------------------------------------------------------
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+//--------------------------------------------------------------------------------
+
+static void test_benchmark_wifi()
+{
+    for (uint32_t size : backlog_sizes)
+        benchmark("wifi", network_wifi, size);
+}
+
+static void test_benchmark_lossy()
+{
+    for (uint32_t size : backlog_sizes)
+        benchmark("lossy", network_lossy, size);
+}
+
+static void test_benchmark_throttled()
+{
+    for (uint32_t size : backlog_sizes)
+        benchmark("throttled", network_throttled, size);
+}
+
+static void test_batch_requests()
+{
+    RtdbStandIn database(network_wifi, 1);
+    HostSender sender(database, email, DEVICE_ID);
+    std::deque<data> backlog;
+
+    for (uint32_t i = 0; i < 3 * SENDER_BATCH_RECORDS_MAX; i++)
+        backlog.push_back(measurement_at(i));
+
+    data measurement = measurement_at(3 * SENDER_BATCH_RECORDS_MAX);
+    TEST_ASSERT_TRUE(sender.send_data((uint64_t)measurement.time * 1000000, backlog, &measurement));
+
+    /* Sign-in, three full batches and the current measurement alone, on one connection. */
+    TEST_ASSERT_EQUAL_UINT32(5, sender.get_stats().requests);
+    TEST_ASSERT_EQUAL_UINT32(4, sender.get_stats().batches);
+    TEST_ASSERT_EQUAL_UINT32(2, database.get_stats().handshakes);
+    TEST_ASSERT_EQUAL_UINT32(4 * (3 * SENDER_BATCH_RECORDS_MAX + 1), database.get_stats().values);
+}
+
+static void test_untimed_measurement()
+{
+    RtdbStandIn database(network_wifi, 1);
+    HostSender sender(database, email, DEVICE_ID);
+    std::deque<data> backlog;
+
+    /* The same values, only the sequence numbers differ. */
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        data measurement = measurement_at(0);
+        measurement.time = HOST_SENDER_TIME_ERROR;
+        measurement.sequence = i;
+        backlog.push_back(measurement);
+    }
+
+    TEST_ASSERT_TRUE(sender.send_data((uint64_t)EPOCH_START * 1000000, backlog, nullptr));
+
+    /* Both get distinct keys of their sequence numbers, without the time subpath. */
+    std::string readings = "UsersData/" + sender.get_uid() + "/readings";
+    TEST_ASSERT_EQUAL_size_t(2, database.count(readings + "/temperature"));
+    TEST_ASSERT_EQUAL_size_t(0, database.count(readings + "/time"));
+    TEST_ASSERT_EQUAL_UINT32(0, database.get_stats().malformed);
+}
+
+static void test_record_keys()
+{
+    data measurement = measurement_at(7);
+    char key[SENDER_KEY_BUF_SIZE];
+    char again[SENDER_KEY_BUF_SIZE];
+
+    /* A retried record gets the same key, also after the round trip through the log. */
+    uint8_t buffer[MEASUREMENT_CODEC_MAX_SIZE];
+    data decoded;
+    MeasurementCodec encoder;
+    MeasurementCodec decoder;
+    size_t length = encoder.encode(measurement, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_size_t(length, decoder.decode(buffer, length, &decoded));
+
+    sender_record_key(measurement, DEVICE_ID, true, key);
+    sender_record_key(decoded, DEVICE_ID, true, again);
+    TEST_ASSERT_EQUAL_STRING(key, again);
+    TEST_ASSERT_EQUAL_size_t(SENDER_PUSH_KEY_SIZE, strlen(key));
+
+    /* Another device or another reading at the same second gets another key. */
+    sender_record_key(measurement, DEVICE_ID + 1, true, again);
+    TEST_ASSERT_TRUE(strcmp(key, again) != 0);
+
+    decoded.sequence++;
+    sender_record_key(decoded, DEVICE_ID, true, again);
+    TEST_ASSERT_TRUE(strcmp(key, again) != 0);
+
+    /* Keys of records without time start with the prefix and sort by the sequence. */
+    measurement.time = HOST_SENDER_TIME_ERROR;
+    sender_record_key(measurement, DEVICE_ID, false, key);
+    measurement.sequence++;
+    sender_record_key(measurement, DEVICE_ID, false, again);
+    TEST_ASSERT_EQUAL_INT(SENDER_UNTIMED_KEY_PREFIX[0], key[0]);
+    TEST_ASSERT_TRUE(strcmp(key, again) < 0);
+}
+
+static void test_lost_replies()
+{
+    /* Most answers to applied updates are lost, the retries write the same keys again. */
+    rtdb_stand_in_config config = network_wifi;
+    config.reply_loss_rate = 0.5f;
+
+    RtdbStandIn database(config, 1);
+    HostSender sender(database, email, DEVICE_ID);
+    std::deque<data> backlog;
+    uint32_t index = 0;
+
+    for (; index < 4 * SENDER_BATCH_RECORDS_MAX; index++)
+        backlog.push_back(measurement_at(index));
+
+    bool sent = false;
+    while (!sent && (sender.get_stats().wakes < WAKES_MAX))
+    {
+        data measurement = measurement_at(index++);
+        sent = sender.send_data((uint64_t)measurement.time * 1000000, backlog, &measurement);
+    }
+
+    std::string readings = "UsersData/" + sender.get_uid() + "/readings";
+    TEST_ASSERT_TRUE(sent);
+    TEST_ASSERT_TRUE(database.get_stats().lost_replies > 0);
+    TEST_ASSERT_TRUE(database.get_stats().rewrites > 0);
+    TEST_ASSERT_EQUAL_size_t(index, database.count(readings + "/temperature"));
+    TEST_ASSERT_EQUAL_size_t(index, database.count(readings + "/time"));
+}
+
+static void test_token_refresh()
+{
+    /* The database expires tokens before the client expects it, the rejected update is retried with a new one. */
+    rtdb_stand_in_config config = network_wifi;
+    config.token_lifetime = WAKE_INTERVAL / 2;
+
+    RtdbStandIn database(config, 1);
+    HostSender sender(database, email, DEVICE_ID);
+    std::deque<data> backlog;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        data measurement = measurement_at(i);
+        TEST_ASSERT_TRUE(sender.send_data((uint64_t)measurement.time * 1000000, backlog, &measurement));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, database.get_stats().sign_ins);
+    TEST_ASSERT_EQUAL_UINT32(3, database.get_stats().refreshes);
+    TEST_ASSERT_EQUAL_UINT32(3, database.get_stats().unauthorized);
+    TEST_ASSERT_EQUAL_size_t(4, database.count("UsersData/" + sender.get_uid() + "/readings/plato"));
+}
+
+static void test_stand_in_rejects_invalid_updates()
+{
+    RtdbStandIn database(network_wifi, 1);
+    std::string token, refresh_token, uid;
+
+    database.sign_in(0, false, "other@example.com", &token, &refresh_token, &uid);
+    std::string readings = "UsersData/" + uid + "/readings";
+
+    TEST_ASSERT_EQUAL_INT(RTDB_STATUS_NO_CONTENT, database.update(0, true, token, readings, "{\"plato/a\":1.5,\"time/a\":10}").status);
+    TEST_ASSERT_EQUAL_INT(RTDB_STATUS_BAD_REQUEST, database.update(0, true, token, readings, "{\"plato/a\":1.5,\"plato\":2}").status);
+    TEST_ASSERT_EQUAL_INT(RTDB_STATUS_BAD_REQUEST, database.update(0, true, token, readings, "{\"plato/a.b\":1.5}").status);
+    TEST_ASSERT_EQUAL_INT(RTDB_STATUS_BAD_REQUEST, database.update(0, true, token, readings, "{\"plato/a\":1.5").status);
+    TEST_ASSERT_EQUAL_INT(RTDB_STATUS_BAD_REQUEST, database.update(0, true, token, readings, "{\"plato/a\":x}").status);
+    TEST_ASSERT_EQUAL_INT(RTDB_STATUS_UNAUTHORIZED, database.update(0, true, token, "UsersData/other/readings", "{\"plato/a\":1}").status);
+    TEST_ASSERT_EQUAL_INT(RTDB_STATUS_UNAUTHORIZED, database.update(0, true, "token", readings, "{\"plato/a\":1}").status);
+
+    /* Only the first update was applied. */
+    TEST_ASSERT_EQUAL_size_t(1, database.count(readings + "/plato"));
+    TEST_ASSERT_EQUAL_STRING("1.5", database.get(readings + "/plato/a")->c_str());
+}
+
+//--------------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_batch_requests);
+    RUN_TEST(test_untimed_measurement);
+    RUN_TEST(test_record_keys);
+    RUN_TEST(test_lost_replies);
+    RUN_TEST(test_token_refresh);
+    RUN_TEST(test_stand_in_rejects_invalid_updates);
+    RUN_TEST(test_benchmark_wifi);
+    RUN_TEST(test_benchmark_lossy);
+    RUN_TEST(test_benchmark_throttled);
+    return UNITY_END();
+}
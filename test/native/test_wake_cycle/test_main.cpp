@@ -0,0 +1,321 @@
+/**
+ * @file test_main.cpp
+ * @author Kacper Wiśniewski (kwisniewski541@gmail.com)
+ * @version 1.0
+ * @date 2026-10-17
+ */
+
+//--------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <math.h>
+#include <functional>
+#include <vector>
+#include <unity.h>
+#include <Esp.h>
+#include <plato_table.h>
+#include <host_device.h>
+
+//--------------------------------------------------------------------------------
+/* Private constants and variables. */
+
+/** @brief Start of the simulation since epoch, in us. */
+#define WAKE_EPOCH_START        (1790000000ULL * 1000000)
+
+/** @brief Configured interval between wake-ups, in us. */
+#define WAKE_SLEEP_TIME         900000000ULL
+
+/** @brief Offset of the time zone the firmware adds to the stored time, UTC_OFFSET_SEC. */
+#define WAKE_UTC_OFFSET         3600
+
+#define MINUTE                  60000000ULL
+#define HOUR                    3600000000ULL
+
+static const char *email = "brewer@example.com";
+
+/** @brief Calibration of the hydrometer, the same as in the config file. */
+static const float coefficients[5] = {0.0f, 0.0f, 0.000001f, 0.0017f, 0.955f};
+
+static const char *config_json =
+    "{\"ssid\":\"brewery\",\"pass\":\"wort1234\",\"api_key\":\"key\",\"email\":\"brewer@example.com\","
+    "\"firebase_password\":\"secret\",\"database_url\":\"https://hydrometer.example.com\",\"sleep_time\":\"900000000\","
+    "\"coeff_a\":\"0\",\"coeff_b\":\"0\",\"coeff_c\":\"0.000001\",\"coeff_d\":\"0.0017\",\"coeff_e\":\"0.955\"}";
+
+/** @brief Database of a home brewer, a good link without failures so the counts are exact. */
+static const rtdb_stand_in_config network_home =
+{
+    .latency = 60000, .jitter = 40000, .handshake = 1500000, .bandwidth = 50000, .service = 200, .workers = 8,
+    .rate_limit = 0, .auth_service = 150000, .token_lifetime = 3600, .timeout = 5000000, .error_rate = 0, .loss_rate = 0,
+    .reply_loss_rate = 0
+};
+
+//--------------------------------------------------------------------------------
+/* Private functions declarations. */
+
+static float fermentation_tilt(uint64_t time);
+static float no_swing(uint64_t time);
+static float bump_swing(uint64_t time);
+static float cellar_temperature(uint64_t time);
+static float full_battery(uint64_t time);
+static bool network_up(uint64_t time);
+static bool network_outage(uint64_t time);
+static host_device_config device_config(const host_environment &environment);
+static std::vector<host_wake> run(HostDevice &device, uint64_t duration);
+static std::string readings_path();
+static void report(const char *name, const HostDevice &device, const RtdbStandIn &database, const std::vector<host_wake> &wakes);
+
+//--------------------------------------------------------------------------------
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+//--------------------------------------------------------------------------------
+
+static void test_fermentation()
+{
+    RtdbStandIn database(network_home, 1);
+    HostDevice device(device_config({fermentation_tilt, no_swing, cellar_temperature, full_battery, network_up}),
+                      database, WAKE_EPOCH_START);
+
+    TEST_ASSERT_TRUE(device.write_file("/config.json", config_json));
+    std::vector<host_wake> wakes = run(device, 12 * HOUR);
+    report("fermentation", device, database, wakes);
+
+    /* The first wake-up follows the power-up, every one ends in deep sleep on the grid. */
+    TEST_ASSERT_EQUAL_UINT32(REASON_DEFAULT_RST, wakes.front().reset_reason);
+    for (size_t i = 0; i < wakes.size(); i++)
+    {
+        TEST_ASSERT_EQUAL_INT(HOST_EXIT_SLEEP, wakes[i].status);
+        TEST_ASSERT_TRUE(wakes[i].sleep <= WAKE_SLEEP_TIME + MINUTE);
+        TEST_ASSERT_TRUE(wakes[i].awake < 10000000);
+        if (i > 0)
+            TEST_ASSERT_EQUAL_UINT32(REASON_DEEP_SLEEP_AWAKE, wakes[i].reset_reason);
+    }
+
+    /* Every measurement is stored once, in the order of the wake-ups. */
+    std::vector<std::string> keys = database.children(readings_path() + "/plato");
+    TEST_ASSERT_EQUAL_size_t(wakes.size(), keys.size());
+    TEST_ASSERT_EQUAL_size_t(wakes.size(), database.count(readings_path() + "/time"));
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        float plato = strtof(database.get(readings_path() + "/plato/" + keys[i])->c_str(), nullptr);
+        float temperature = strtof(database.get(readings_path() + "/temperature/" + keys[i])->c_str(), nullptr);
+        long time = strtol(database.get(readings_path() + "/time/" + keys[i])->c_str(), nullptr, 10);
+
+        /* The tilt is the trimmed mean of the burst, the noise of the samples averages out. */
+        TEST_ASSERT_FLOAT_WITHIN(0.15f, PlatoTable::calculate(coefficients, fermentation_tilt(wakes[i].start), temperature), plato);
+        TEST_ASSERT_FLOAT_WITHIN(0.6f, cellar_temperature(wakes[i].start) - 2, temperature);
+        TEST_ASSERT_TRUE(labs((long)(wakes[i].start / 1000000) + WAKE_UTC_OFFSET - time) <= 10);
+    }
+
+    /* The ID token is saved in the flash, later wake-ups neither sign in nor refresh it while it is valid. */
+    const rtdb_stand_in_stats &stats = database.get_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.sign_ins);
+    TEST_ASSERT_TRUE(stats.refreshes <= 12 * HOUR / (network_home.token_lifetime * 1000000ULL) + 1);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.malformed);
+
+    /* A stable temperature is converted at the low resolution, the resolution is never written to EEPROM. */
+    const host_state &state = device.get_state();
+    TEST_ASSERT_EQUAL_UINT32(0, state.ds18b20.eeprom_writes);
+    TEST_ASSERT_EQUAL_UINT32(0x1F, state.ds18b20.scratchpad[4]);
+    TEST_ASSERT_EQUAL_UINT32(wakes.size(), state.ds18b20.conversions);
+
+    /* Later wake-ups connect to the cached access point with the cached address. */
+    uint64_t awake = 0;
+    for (size_t i = 1; i < wakes.size(); i++)
+        awake += wakes[i].awake;
+
+    TEST_ASSERT_TRUE(awake / (wakes.size() - 1) < wakes.front().awake);
+}
+
+static void test_network_outage()
+{
+    RtdbStandIn database(network_home, 2);
+    HostDevice device(device_config({fermentation_tilt, no_swing, cellar_temperature, full_battery, network_outage}),
+                      database, WAKE_EPOCH_START);
+
+    TEST_ASSERT_TRUE(device.write_file("/config.json", config_json));
+    std::vector<host_wake> wakes = run(device, 12 * HOUR);
+    report("outage", device, database, wakes);
+
+    /* The measurements of the outage wait in the flash log, the first wake-up after it uploads them. */
+    size_t offline = 0;
+    for (const host_wake &wake : wakes)
+    {
+        TEST_ASSERT_EQUAL_INT(HOST_EXIT_SLEEP, wake.status);
+        offline += !network_outage(wake.start);
+    }
+
+    TEST_ASSERT_TRUE(offline > 0);
+    TEST_ASSERT_EQUAL_size_t(wakes.size(), database.count(readings_path() + "/plato"));
+    TEST_ASSERT_EQUAL_UINT32(0, database.get_stats().rewrites);
+    TEST_ASSERT_TRUE(device.get_state().flash.written > 0);
+}
+
+static void test_motion_disturbance()
+{
+    RtdbStandIn database(network_home, 3);
+    HostDevice device(device_config({fermentation_tilt, bump_swing, cellar_temperature, full_battery, network_up}),
+                      database, WAKE_EPOCH_START);
+
+    TEST_ASSERT_TRUE(device.write_file("/config.json", config_json));
+    std::vector<host_wake> wakes = run(device, 6 * HOUR);
+    report("disturbance", device, database, wakes);
+
+    /* The reading of a wake-up during the swinging is skipped, the swinging is seen by the motion interrupt in sleep. */
+    size_t disturbed = 0;
+    for (const host_wake &wake : wakes)
+    {
+        TEST_ASSERT_EQUAL_INT(HOST_EXIT_SLEEP, wake.status);
+        disturbed += (bump_swing(wake.start) > 0);
+    }
+
+    size_t stored = database.count(readings_path() + "/plato");
+    TEST_ASSERT_TRUE(disturbed > 0);
+    TEST_ASSERT_TRUE(stored < wakes.size());
+    TEST_ASSERT_TRUE(stored >= wakes.size() - disturbed);
+}
+
+//--------------------------------------------------------------------------------
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fermentation);
+    RUN_TEST(test_network_outage);
+    RUN_TEST(test_motion_disturbance);
+    return UNITY_END();
+}
+
+//--------------------------------------------------------------------------------
+
+/**
+ * @brief Tilt of a fermentation, the hydrometer rises as the sugar is converted.
+ * @param [in] time - time since epoch, in us
+ * @return float - tilt in degrees
+ */
+static float fermentation_tilt(uint64_t time)
+{
+    double hours = (double)(time - WAKE_EPOCH_START) / HOUR;
+
+    return 35 + 20 * exp(-hours / 24);
+}
+
+/** @brief The hydrometer floats still. */
+static float no_swing(uint64_t time)
+{
+    (void)time;
+    return 0;
+}
+
+/** @brief The fermenter is moved at the second hour, the hydrometer swings for half an hour. */
+static float bump_swing(uint64_t time)
+{
+    uint64_t elapsed = time - WAKE_EPOCH_START;
+
+    return ((elapsed >= 2 * HOUR) && (elapsed < 2 * HOUR + 30 * MINUTE)) ? 8 : 0;
+}
+
+/** @brief Temperature of a cellar, stable within a tenth of a degree. */
+static float cellar_temperature(uint64_t time)
+{
+    return 18.3f + 0.05f * sinf((float)(time - WAKE_EPOCH_START) / HOUR);
+}
+
+static float full_battery(uint64_t time)
+{
+    (void)time;
+    return 4.1f;
+}
+
+static bool network_up(uint64_t time)
+{
+    (void)time;
+    return true;
+}
+
+/** @brief The access point is down from the third to the sixth hour. */
+static bool network_outage(uint64_t time)
+{
+    uint64_t elapsed = time - WAKE_EPOCH_START;
+
+    return (elapsed < 3 * HOUR) || (elapsed >= 6 * HOUR);
+}
+
+/**
+ * @brief Get the configuration of the simulated hydrometer.
+ * @param [in] environment - environment of the device
+ * @return host_device_config - configuration
+ */
+static host_device_config device_config(const host_environment &environment)
+{
+    host_device_config config =
+    {
+        .environment = environment, .chip_id = 0x00A1B2C3, .seed = 12345, .tilt_noise = 0.3f, .sleep_drift = 300,
+        .ssid = "brewery", .password = "wort1234", .connect_time = 2500, .fast_connect_time = 350, .lease = 86400
+    };
+
+    return config;
+}
+
+/**
+ * @brief Runs the wake-ups of the device for the time.
+ * @param [in] device - device
+ * @param [in] duration - simulated time, in us
+ * @return std::vector<host_wake> - results of the wake-ups
+ */
+static std::vector<host_wake> run(HostDevice &device, uint64_t duration)
+{
+    std::vector<host_wake> wakes;
+    uint64_t end = device.get_time() + duration;
+
+    while (device.get_time() < end)
+    {
+        wakes.push_back(device.wake());
+        if (wakes.back().status != HOST_EXIT_SLEEP)
+            break;
+    }
+
+    return wakes;
+}
+
+/**
+ * @brief Get the path of the readings of the user, the stand-in derives the user ID from the email.
+ * @return std::string - path
+ */
+static std::string readings_path()
+{
+    return "UsersData/u" + std::to_string(std::hash<std::string>()(email) % 1000000000) + "/readings";
+}
+
+/**
+ * @brief Prints the wake-ups, the traffic and the work of the simulated parts.
+ */
+static void report(const char *name, const HostDevice &device, const RtdbStandIn &database, const std::vector<host_wake> &wakes)
+{
+    const host_state &state = device.get_state();
+    const rtdb_stand_in_stats &stats = database.get_stats();
+    uint64_t awake = 0;
+    uint64_t awake_max = 0;
+    char text[320];
+
+    for (const host_wake &wake : wakes)
+    {
+        awake += wake.awake;
+        awake_max = std::max(awake_max, wake.awake);
+    }
+
+    snprintf(text, sizeof(text),
+             "%-12s %3zu wake-ups: awake mean %5.0f ms first %5.0f ms max %5.0f ms, %u updates, %u sign-ins, %u refreshes, "
+             "%u handshakes, flash %llu B written %llu B read, %u I2C transactions, %u conversions",
+             name, wakes.size(), (double)awake / wakes.size() / 1e3, wakes.front().awake / 1e3, awake_max / 1e3,
+             stats.updates, stats.sign_ins, stats.refreshes, stats.handshakes, (unsigned long long)state.flash.written,
+             (unsigned long long)state.flash.read, state.mpu6050.transactions, state.ds18b20.conversions);
+    TEST_MESSAGE(text);
+}